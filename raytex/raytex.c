@@ -1,9 +1,43 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
+#include <time.h>
 #include "raytex.h"
+#include "rlgl.h"
 
-#define MAX_TEXT_BUFFER_LENGTH 1024
+#if !defined(RAYTEX_NO_THREADS) && !defined(__STDC_NO_THREADS__)
+    #define RAYTEX_THREADS
+    #include <threads.h>
+#endif
+#if defined(_WIN32)
+    // Declared here because windows.h clashes with raylib.h
+    __declspec(dllimport) unsigned long __stdcall GetActiveProcessorCount(unsigned short groupNumber);
+    __declspec(dllimport) void *__stdcall CreateFileA(const char *fileName, unsigned long access, unsigned long shareMode, void *security, unsigned long creation, unsigned long flags, void *templateFile);
+    __declspec(dllimport) int __stdcall GetFileSizeEx(void *file, long long *size);
+    __declspec(dllimport) void *__stdcall CreateFileMappingA(void *file, void *security, unsigned long protect, unsigned long maxSizeHigh, unsigned long maxSizeLow, const char *name);
+    __declspec(dllimport) void *__stdcall MapViewOfFile(void *mapping, unsigned long access, unsigned long offsetHigh, unsigned long offsetLow, size_t size);
+    __declspec(dllimport) int __stdcall UnmapViewOfFile(const void *address);
+    __declspec(dllimport) int __stdcall CloseHandle(void *handle);
+#else
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#define RAYTEX_SYMBOLS_IMPLEMENTATION
+#include "raytex_symbols.h"
+
+#define RAYTEX_DEFAULT_ARENA_BLOCK_SIZE 16384
+#define MAX_FONT_GLYPH_CACHES 8
+#define RAYTEX_CLIP_MARGIN 18 // mu around an element's box that its glyphs may still reach into when culling
+#define MAX_SHARED_LAYOUTS 4 // Fonts and font sizes an interned element keeps layouts for, besides its current one
+#define FONT_GLYPHS_ASCII_COUNT 128
+#ifndef RAYTEX_PARALLEL_LAYOUT_THRESHOLD
+    #define RAYTEX_PARALLEL_LAYOUT_THRESHOLD 512 // Containers with fewer children are laid out on the calling thread, 0 to never split
+#endif
+#define RAYTEX_PARALLEL_LAYOUT_GRAIN 32          // Children a layout worker takes at a time
 #define TRACELOG(level, ...) TraceLog(level, __VA_ARGS__)
 
 enum {
@@ -12,776 +46,4888 @@ enum {
     TEXFRAC_THICKNESS = 1, // Measured in mu
 };
 
-RayTeXSymbol RayTeXSymbolFromName(const char *name)
+enum {
+    TEXMATRIX_COLUMN_SPACING = QUAD_SIZE, // Measured in mu
+    TEXMATRIX_ROW_SPACING    = 4,         // Measured in mu
+};
+
+static void *rDefaultAlloc(void *userData, size_t size)
 {
-    // todo: Implement this as a lookup table once there are a lot of symbols
-    if (TextIsEqual(name, "neq")) return TEXSYMBOL_NEQ;
+    return RL_MALLOC(size);
+}
 
-    TRACELOG(LOG_WARNING, "RAYTEX: Unknown symbol \"%s\"", name);
+static void rDefaultFree(void *userData, void *ptr)
+{
+    RL_FREE(ptr);
 }
 
-Vector2 MeasureRayTeXSymbolEx(Font font, RayTeXSymbol symbol, float fontSize)
+static RayTeXAllocator currentAllocator = { NULL, rDefaultAlloc, rDefaultFree };
+
+#if defined(RAYTEX_STATS)
+static RayTeXStats stats = { 0 };
+static RayTeXStatsScopeCallback statsScopeCallback = NULL;
+
+#if defined(RAYTEX_THREADS)
+// Worker threads count into their own stats, which are added to the totals when they finish
+static _Thread_local RayTeXStats *threadStats = NULL;
+#define RAYTEX_STATS_ADD(field, value) ((threadStats != NULL) ? (void)(threadStats->field += (value)) : (void)(stats.field += (value)))
+#else
+#define RAYTEX_STATS_ADD(field, value) ((void)(stats.field += (value)))
+#endif
+
+// Times a public entry point, and tells the scope callback when it starts and ends
+#define RAYTEX_STATS_BEGIN(scope) double statsStartTime = rBeginStatsScope(scope)
+#define RAYTEX_STATS_END(scope, timeField) rEndStatsScope(scope, statsStartTime, &stats.timeField)
+
+static double rGetStatsTime(void)
 {
-    Vector2 size = { 0 };
-    switch (symbol)
-    {
-    case TEXSYMBOL_NEQ:
-    {
-        Vector2 baseSize = MeasureTextEx(font, "=", fontSize, fontSize / 10);
-        size.x = baseSize.x + MU_TO_PIXELS(RELSPACE_SIZE*2.0f, fontSize);
-        size.y = baseSize.y;
-    }
-        break;
+    struct timespec time = { 0 };
+    timespec_get(&time, TIME_UTC);
+    return (double)time.tv_sec + (double)time.tv_nsec*1e-9;
+}
 
-    default: TRACELOG(LOG_WARNING, "RAYTEX: Unknown symbol [%i]", symbol);
-    }
-    return size;
+static double rBeginStatsScope(const char *scope)
+{
+    if (statsScopeCallback != NULL) statsScopeCallback(scope, false);
+    return rGetStatsTime();
 }
 
-int MeasureRayTeXSymbolWidth(RayTeXSymbol symbol, int fontSize)
+static void rEndStatsScope(const char *scope, double startTime, double *time)
 {
-    return (int)MeasureRayTeXSymbolEx(GetFontDefault(), symbol, (float)fontSize).x;
+    *time += rGetStatsTime() - startTime;
+    if (statsScopeCallback != NULL) statsScopeCallback(scope, true);
 }
 
-int MeasureRayTeXSymbolHeight(RayTeXSymbol symbol, int fontSize)
+#if defined(RAYTEX_THREADS)
+static void rAddStats(RayTeXStats *stats, const RayTeXStats *other)
 {
-    return (int)MeasureRayTeXSymbolEx(GetFontDefault(), symbol, (float)fontSize).y;
+    stats->layoutCount += other->layoutCount;
+    stats->layoutCacheHits += other->layoutCacheHits;
+    stats->layoutCacheMisses += other->layoutCacheMisses;
+    stats->drawNodeCount += other->drawNodeCount;
+    stats->drawCulledCount += other->drawCulledCount;
+    stats->measureTextCount += other->measureTextCount;
+    stats->drawTextCount += other->drawTextCount;
+    stats->bytesAllocated += other->bytesAllocated;
+    stats->bytesFreed += other->bytesFreed;
+    stats->liveNodeCount += other->liveNodeCount;
+    stats->internHits += other->internHits;
+    stats->measureTime += other->measureTime;
+    stats->drawTime += other->drawTime;
 }
+#endif
 
-void DrawRayTeXSymbolEx(Font font, RayTeXSymbol symbol, Vector2 position, float fontSize, Color color)
+// Allocations carry their size in front of them, so that frees can be counted in bytes
+#define RAYTEX_STATS_HEADER_SIZE 16
+
+static void *rStatsAlloc(size_t size)
 {
-    // Todo: Implement these with textures or a custom font at some point
-    Vector2 size = MeasureRayTeXSymbolEx(font, symbol, fontSize);
-    switch (symbol)
-    {
-    case TEXSYMBOL_NEQ:
-    {
-        float space = MU_TO_PIXELS((float)RELSPACE_SIZE, (float)fontSize);
+    unsigned char *memory = currentAllocator.Alloc(currentAllocator.userData, size + RAYTEX_STATS_HEADER_SIZE);
+    if (memory == NULL) return NULL;
+    memcpy(memory, &size, sizeof(size_t));
+    RAYTEX_STATS_ADD(bytesAllocated, (long long)size);
+    return memory + RAYTEX_STATS_HEADER_SIZE;
+}
 
-        Vector2 positionWithSpace = { 0 };
-        positionWithSpace.x = position.x + space;
-        positionWithSpace.y = position.y;
-        DrawTextEx(font, "=", positionWithSpace, fontSize, fontSize / 10, color);
+static void rStatsFree(void *ptr)
+{
+    if (ptr == NULL) return;
+    unsigned char *memory = (unsigned char *)ptr - RAYTEX_STATS_HEADER_SIZE;
+    size_t size = 0;
+    memcpy(&size, memory, sizeof(size_t));
+    RAYTEX_STATS_ADD(bytesFreed, (long long)size);
+    currentAllocator.Free(currentAllocator.userData, memory);
+}
 
-        Vector2 crossBottomLeft = { position.x + space, position.y + size.y };
-        Vector2 crossTopRight = { position.x + size.x - space, position.y };
-        DrawLineV(crossBottomLeft, crossTopRight, color);
-    }
-        break;
+#define RAYTEX_MALLOC(size) rStatsAlloc(size)
+#define RAYTEX_FREE(ptr)    rStatsFree((void *)(ptr))
+#else
+#define RAYTEX_STATS_ADD(field, value) ((void)0)
+#define RAYTEX_STATS_BEGIN(scope) ((void)0)
+#define RAYTEX_STATS_END(scope, timeField) ((void)0)
 
-    default: TRACELOG(LOG_WARNING, "RAYTEX: Unknown symbol [%i]", symbol);
-    }
+#define RAYTEX_MALLOC(size) currentAllocator.Alloc(currentAllocator.userData, (size))
+#define RAYTEX_FREE(ptr)    currentAllocator.Free(currentAllocator.userData, (void *)(ptr))
+#endif
+
+RayTeXStats GetRayTeXStats(void)
+{
+#if defined(RAYTEX_STATS)
+    return stats;
+#else
+    RayTeXStats empty = { 0 };
+    return empty;
+#endif
 }
 
-void DrawRayTeXSymbol(RayTeXSymbol symbol, int x, int y, int fontSize, Color color)
+void ResetRayTeXStats(void)
 {
-    Vector2 position = { 0 };
-    position.x = (float)x;
-    position.y = (float)y;
-    DrawRayTeXSymbolEx(GetFontDefault(), symbol, position, (float)fontSize, color);
+#if defined(RAYTEX_STATS)
+    // Live nodes describe what exists rather than what happened, so they are kept
+    long long liveNodeCount = stats.liveNodeCount;
+    memset(&stats, 0, sizeof(RayTeXStats));
+    stats.liveNodeCount = liveNodeCount;
+#endif
 }
 
-static Vector2 rMeasureRayTeX(const Font *font, const RayTeX *tex, float fontSize)
+void SetRayTeXStatsScopeCallback(RayTeXStatsScopeCallback callback)
 {
-    Vector2 size = { 0 };
-    if (tex->isOverridingFontSize) fontSize = (float)tex->overrideFontSize;
-    if (tex->overrideFont != NULL) font = tex->overrideFont;
-    switch (tex->mode)
-    {
-    case TEXMODE_SPACE:
-        size.x = MU_TO_PIXELS((float)tex->space.size, fontSize);
-        size.y = 0.0f;
-        break;
+#if defined(RAYTEX_STATS)
+    statsScopeCallback = callback;
+#endif
+}
 
-    case TEXMODE_VSPACE:
-        size.x = 0.0f;
-        size.y = MU_TO_PIXELS((float)tex->space.size, fontSize);
-        break;
+void SetRayTeXAllocator(RayTeXAllocator allocator)
+{
+    currentAllocator = allocator;
+}
 
-    case TEXMODE_TEXT:
-        size = MeasureTextEx(*font, tex->text.content, fontSize, fontSize / 10);
-        break;
+RayTeXAllocator GetRayTeXAllocator(void)
+{
+    return currentAllocator;
+}
 
-    case TEXMODE_SYMBOL:
-        size = MeasureRayTeXSymbolEx(*font, tex->symbol.content, fontSize);
-        break;
+RayTeXAllocator GetRayTeXDefaultAllocator(void)
+{
+    RayTeXAllocator allocator = { NULL, rDefaultAlloc, rDefaultFree };
+    return allocator;
+}
 
-    case TEXMODE_FRAC:
+// Header of every arena block, followed by its data
+struct RayTeXArenaBlock {
+    struct RayTeXArenaBlock *next;
+    size_t capacity;
+};
+
+#define RAYTEX_ARENA_ALIGNMENT 16
+#define RAYTEX_ARENA_HEADER_SIZE ((sizeof(struct RayTeXArenaBlock) + RAYTEX_ARENA_ALIGNMENT - 1) & ~(size_t)(RAYTEX_ARENA_ALIGNMENT - 1))
+
+RayTeXArena LoadRayTeXArena(int blockSize)
+{
+    RayTeXArena arena = { 0 };
+    arena.blockSize = (blockSize > 0) ? blockSize : RAYTEX_DEFAULT_ARENA_BLOCK_SIZE;
+    return arena;
+}
+
+void ResetRayTeXArena(RayTeXArena *arena)
+{
+    // Keep one regular block around so that rebuilding the same formulas does not allocate again
+    struct RayTeXArenaBlock *kept = NULL;
+    struct RayTeXArenaBlock *block = arena->blocks;
+    while (block != NULL)
     {
-        Vector2 numeratorSize = rMeasureRayTeX(font, tex->frac.content[TEX_FRAC_NUMERATOR].ptr, fontSize);
-        Vector2 denominatorSize = rMeasureRayTeX(font, tex->frac.content[TEX_FRAC_DENOMINATOR].ptr, fontSize);
-        size.x = (numeratorSize.x > denominatorSize.x ? numeratorSize.x : denominatorSize.x) + MU_TO_PIXELS(TEXFRAC_OVERHANG*2.0f, fontSize);
-        size.y = numeratorSize.y + denominatorSize.y + MU_TO_PIXELS(TEXFRAC_SPACING*2.0f+TEXFRAC_THICKNESS, fontSize);
+        struct RayTeXArenaBlock *next = block->next;
+        if ((kept == NULL) && (block->capacity == (size_t)arena->blockSize)) kept = block;
+        else RL_FREE(block);
+        block = next;
     }
-        break;
+    if (kept != NULL) kept->next = NULL;
+    arena->blocks = kept;
+    arena->used = 0;
+}
 
-    case TEXMODE_HORIZONTAL:
+void UnloadRayTeXArena(RayTeXArena *arena)
+{
+    ResetRayTeXArena(arena);
+    RL_FREE(arena->blocks);
+    arena->blocks = NULL;
+}
+
+static void *rArenaAlloc(void *userData, size_t size)
+{
+    RayTeXArena *arena = userData;
+    size = (size + RAYTEX_ARENA_ALIGNMENT - 1) & ~(size_t)(RAYTEX_ARENA_ALIGNMENT - 1);
+
+    if ((arena->blocks == NULL) || (arena->used + size > arena->blocks->capacity))
     {
-        float totalWidth = 0.0f;
-        float maxHeight = 0.0f;
-        for (int i = 0; i < tex->horizontal.elementCount; ++i)
+        // Oversized allocations get a block of their own, behind the current one so it can keep filling up
+        size_t capacity = (size > (size_t)arena->blockSize) ? size : (size_t)arena->blockSize;
+        struct RayTeXArenaBlock *block = RL_MALLOC(RAYTEX_ARENA_HEADER_SIZE + capacity);
+        if (block == NULL)
         {
-            RayTeX *element = tex->horizontal.content[i].ptr;
-            Vector2 elementSize = rMeasureRayTeX(font, element, fontSize);
-            totalWidth += elementSize.x;
-
-            if (element->mode == TEXMODE_FRAC)
-            {
-                float spacing = MU_TO_PIXELS((float)TEXFRAC_SPACING, fontSize);
-                const Vector2 numeratorSize = rMeasureRayTeX(font, element->frac.content[TEX_FRAC_NUMERATOR].ptr, fontSize);
-                const Vector2 denominatorSize = rMeasureRayTeX(font, element->frac.content[TEX_FRAC_DENOMINATOR].ptr, fontSize);
-                elementSize.y += (numeratorSize.y - denominatorSize.y + spacing) / 2;
-            }
-            if (elementSize.y > maxHeight) maxHeight = elementSize.y;
+            TRACELOG(LOG_ERROR, "RAYTEX: Arena failed to allocate a block of %i bytes", (int)capacity);
+            return NULL;
         }
-        size.x = totalWidth;
-        size.y = maxHeight;
-    }
-        break;
+        block->capacity = capacity;
 
-    case TEXMODE_VERTICAL:
-    {
-        float maxWidth = 0.0f;
-        float totalHeight = 0.0f;
-        for (int i = 0; i < tex->horizontal.elementCount; ++i)
+        if ((capacity > (size_t)arena->blockSize) && (arena->blocks != NULL))
         {
-            Vector2 elementSize = rMeasureRayTeX(font, tex->horizontal.content[i].ptr, fontSize);
-            if (elementSize.x > maxWidth) maxWidth = elementSize.x;
-            totalHeight += elementSize.y;
+            block->next = arena->blocks->next;
+            arena->blocks->next = block;
+            return (unsigned char *)block + RAYTEX_ARENA_HEADER_SIZE;
         }
-        size.x = maxWidth;
-        size.y = totalHeight;
-    }
-        break;
 
-    case TEXMODE_MATRIX:
-    {
-        // todo: measure matrix
-        TRACELOG(LOG_WARNING, "RAYTEX: Matrix measuring not implemented");
+        block->next = arena->blocks;
+        arena->blocks = block;
+        arena->used = 0;
     }
-        break;
 
-    default: TRACELOG(LOG_WARNING, "RAYTEX: Unknown mode [%i]", tex->mode);
-    }
-    return size;
+    void *ptr = (unsigned char *)arena->blocks + RAYTEX_ARENA_HEADER_SIZE + arena->used;
+    arena->used += size;
+    return ptr;
 }
 
-Vector2 MeasureRayTeXEx(Font font, RayTeX tex, int fontSize)
+static void rArenaFree(void *userData, void *ptr)
 {
-    return rMeasureRayTeX(&font, &tex, (float)fontSize);
+    // Arena memory is only released by ResetRayTeXArena()
 }
-int MeasureRayTeXWidth(RayTeX tex, int fontSize)
+
+RayTeXAllocator RayTeXArenaAllocator(RayTeXArena *arena)
 {
-    return (int)MeasureRayTeXEx(GetFontDefault(), tex, fontSize).x;
+    RayTeXAllocator allocator = { arena, rArenaAlloc, rArenaFree };
+    return allocator;
 }
-int MeasureRayTeXHeight(RayTeX tex, int fontSize)
+
+// Glyph indices of one font, so that codepoints are only searched for once
+typedef struct rFontGlyphs {
+    const GlyphInfo *fontId;
+    int glyphCount;
+    int baseSize;
+    int ascii[FONT_GLYPHS_ASCII_COUNT];
+    int hashCapacity;    // Power of two, 0 until the first codepoint outside ASCII
+    int hashCount;
+    int *hashCodepoints; // 0 marks an empty slot
+    int *hashIndices;
+    unsigned int whiteTexelTextureId; // Texture the white texel was searched for, 0 if not searched yet
+    bool isWhiteTexelFound;
+    Rectangle whiteTexel;             // Single solid white pixel in the font's atlas
+} rFontGlyphs;
+
+// Glyph indices of the last few fonts used. Lookups fill it in, so every layout worker has its own.
+typedef struct rGlyphCache {
+    rFontGlyphs fonts[MAX_FONT_GLYPH_CACHES];
+    int nextFont;
+    bool isUnmeasurableWarned;
+} rGlyphCache;
+
+static rGlyphCache glyphCache = { 0 }; // Only used by the calling thread
+
+static rFontGlyphs *rGetCachedFontGlyphs(rGlyphCache *cache, Font font)
 {
-    return (int)MeasureRayTeXEx(GetFontDefault(), tex, fontSize).y;
+    for (int i = 0; i < MAX_FONT_GLYPH_CACHES; ++i)
+    {
+        rFontGlyphs *glyphs = &cache->fonts[i];
+        if ((glyphs->fontId == font.glyphs) && (glyphs->glyphCount == font.glyphCount) && (glyphs->baseSize == font.baseSize)) return glyphs;
+    }
+
+    // Replace the oldest font
+    rFontGlyphs *glyphs = &cache->fonts[cache->nextFont];
+    cache->nextFont = (cache->nextFont + 1) % MAX_FONT_GLYPH_CACHES;
+    RL_FREE(glyphs->hashCodepoints);
+    RL_FREE(glyphs->hashIndices);
+    memset(glyphs, 0, sizeof(rFontGlyphs));
+    glyphs->fontId = font.glyphs;
+    glyphs->glyphCount = font.glyphCount;
+    glyphs->baseSize = font.baseSize;
+    for (int codepoint = 0; codepoint < FONT_GLYPHS_ASCII_COUNT; ++codepoint) glyphs->ascii[codepoint] = GetGlyphIndex(font, codepoint);
+    return glyphs;
 }
 
-void UpdateRayTeXColor(RayTeX *tex, Color color)
+static rFontGlyphs *rGetFontGlyphs(Font font)
 {
-    tex->overrideColor = color;
-    tex->isOverridingColor = true;
+    return rGetCachedFontGlyphs(&glyphCache, font);
 }
 
-void UpdateRayTeXFontSize(RayTeX *tex, int fontSize)
+static void rClearGlyphCache(rGlyphCache *cache)
 {
-    tex->overrideFontSize = fontSize;
-    tex->isOverridingFontSize = true;
+    for (int i = 0; i < MAX_FONT_GLYPH_CACHES; ++i)
+    {
+        RL_FREE(cache->fonts[i].hashCodepoints);
+        RL_FREE(cache->fonts[i].hashIndices);
+    }
+    memset(cache, 0, sizeof(rGlyphCache));
 }
 
-void UpdateRayTeXFont(RayTeX *tex, Font font)
+static bool rGrowFontGlyphs(rFontGlyphs *glyphs)
 {
-    if (tex->overrideFont == NULL) tex->overrideFont = RL_MALLOC(sizeof(Font));
+    int capacity = (glyphs->hashCapacity > 0) ? glyphs->hashCapacity*2 : 64;
+    int *codepoints = RL_CALLOC(capacity, sizeof(int));
+    int *indices = RL_MALLOC(capacity*sizeof(int));
+    if ((codepoints == NULL) || (indices == NULL))
+    {
+        RL_FREE(codepoints);
+        RL_FREE(indices);
+        return false;
+    }
 
-    if (tex->overrideFont != NULL) *tex->overrideFont = font;
-    else TRACELOG(LOG_ERROR, "RAYTEX: UpdateRayTeXFont() failed to allocate");
+    for (int i = 0; i < glyphs->hashCapacity; ++i)
+    {
+        if (glyphs->hashCodepoints[i] == 0) continue;
+        unsigned int slot = ((unsigned int)glyphs->hashCodepoints[i]*2654435761u) & (capacity - 1);
+        while (codepoints[slot] != 0) slot = (slot + 1) & (capacity - 1);
+        codepoints[slot] = glyphs->hashCodepoints[i];
+        indices[slot] = glyphs->hashIndices[i];
+    }
+    RL_FREE(glyphs->hashCodepoints);
+    RL_FREE(glyphs->hashIndices);
+    glyphs->hashCapacity = capacity;
+    glyphs->hashCodepoints = codepoints;
+    glyphs->hashIndices = indices;
+    return true;
 }
 
-void ClearRayTeXColor(RayTeX *tex)
+// Same as GetGlyphIndex(), cached
+static int rGetGlyphIndex(Font font, rFontGlyphs *glyphs, int codepoint)
 {
-    tex->isOverridingColor = false;
+    if ((codepoint >= 0) && (codepoint < FONT_GLYPHS_ASCII_COUNT)) return glyphs->ascii[codepoint];
+
+    if (glyphs->hashCapacity > 0)
+    {
+        unsigned int slot = ((unsigned int)codepoint*2654435761u) & (glyphs->hashCapacity - 1);
+        while (glyphs->hashCodepoints[slot] != 0)
+        {
+            if (glyphs->hashCodepoints[slot] == codepoint) return glyphs->hashIndices[slot];
+            slot = (slot + 1) & (glyphs->hashCapacity - 1);
+        }
+    }
+
+    // Keep the table at most half full so that probes stay short
+    int index = GetGlyphIndex(font, codepoint);
+    if (((glyphs->hashCount + 1)*2 > glyphs->hashCapacity) && !rGrowFontGlyphs(glyphs)) return index;
+
+    unsigned int slot = ((unsigned int)codepoint*2654435761u) & (glyphs->hashCapacity - 1);
+    while (glyphs->hashCodepoints[slot] != 0) slot = (slot + 1) & (glyphs->hashCapacity - 1);
+    glyphs->hashCodepoints[slot] = codepoint;
+    glyphs->hashIndices[slot] = index;
+    glyphs->hashCount++;
+    return index;
 }
 
-void ClearRayTeXFontSize(RayTeX *tex)
+// Same advance that MeasureTextEx() uses for a glyph, at the font's base size
+static float rGlyphAdvance(Font font, int index)
 {
-    tex->isOverridingFontSize = false;
+    if (font.glyphs[index].advanceX != 0) return (float)font.glyphs[index].advanceX;
+    return font.recs[index].width + (float)font.glyphs[index].offsetX;
 }
 
-void ClearRayTeXFont(RayTeX *tex)
+// Same advance that DrawTextEx() uses for a glyph, at the font's base size
+static float rGlyphDrawAdvance(Font font, int index)
 {
-    RL_FREE(tex->overrideFont);
-    tex->overrideFont = NULL;
+    if (font.glyphs[index].advanceX != 0) return (float)font.glyphs[index].advanceX;
+    return font.recs[index].width;
 }
 
-RayTeX RayTeXColor(RayTeX tex, Color color)
+// Same as DrawTextCodepoint(), for a glyph that has already been looked up
+static void rDrawGlyph(Font font, int index, Vector2 position, float fontSize, Color tint)
 {
-    UpdateRayTeXColor(&tex, color);
-    return tex;
+    float scaleFactor = fontSize / (float)font.baseSize;
+    float padding = (float)font.glyphPadding;
+    Rectangle srcRec = { font.recs[index].x - padding, font.recs[index].y - padding,
+                         font.recs[index].width + 2.0f*padding, font.recs[index].height + 2.0f*padding };
+    Rectangle dstRec = { position.x + ((float)font.glyphs[index].offsetX - padding)*scaleFactor,
+                         position.y + ((float)font.glyphs[index].offsetY - padding)*scaleFactor,
+                         srcRec.width*scaleFactor, srcRec.height*scaleFactor };
+    Vector2 origin = { 0 };
+    DrawTexturePro(font.texture, srcRec, dstRec, origin, 0.0f, tint);
 }
 
-RayTeX RayTeXFontSize(RayTeX tex, int fontSize)
+// Checks that a pixel and its neighbours are opaque white, so that filtering does not blend in anything else
+static bool rIsWhiteTexel(Image image, int x, int y)
 {
-    UpdateRayTeXFontSize(&tex, fontSize);
-    return tex;
+    for (int j = y - 1; j <= y + 1; ++j)
+    {
+        for (int i = x - 1; i <= x + 1; ++i)
+        {
+            Color color = GetImageColor(image, i, j);
+            if ((color.r != 255) || (color.g != 255) || (color.b != 255) || (color.a != 255)) return false;
+        }
+    }
+    return true;
 }
 
-RayTeX RayTeXFont(RayTeX tex, Font font)
+// Finds a white pixel in the font's atlas, so that rules and lines can be drawn in the same batch as the glyphs
+// Returns NULL if the atlas has none, in which case they are drawn with the shapes texture
+static const Rectangle *rGetWhiteTexel(Font font)
 {
-    UpdateRayTeXFont(&tex, font);
-    return tex;
+    if (font.texture.id == 0) return NULL;
+
+    rFontGlyphs *glyphs = rGetFontGlyphs(font);
+    if (glyphs->whiteTexelTextureId == font.texture.id) return glyphs->isWhiteTexelFound ? &glyphs->whiteTexel : NULL;
+
+    glyphs->whiteTexelTextureId = font.texture.id;
+    glyphs->isWhiteTexelFound = false;
+    if (GetShapesTexture().id == font.texture.id)
+    {
+        // The default font already shares its atlas with the shapes
+        glyphs->whiteTexel = GetShapesTextureRectangle();
+        glyphs->isWhiteTexelFound = true;
+        return &glyphs->whiteTexel;
+    }
+
+    // Read back once per font - GenImageFontAtlas() puts a 3x3 white square in the bottom-right corner, so look there first
+    Image atlas = LoadImageFromTexture(font.texture);
+    if (atlas.data != NULL)
+    {
+        int texelX = atlas.width - 2;
+        int texelY = atlas.height - 2;
+        bool isFound = (texelX >= 1) && (texelY >= 1) && rIsWhiteTexel(atlas, texelX, texelY);
+        for (int y = 1; !isFound && (y < atlas.height - 1); ++y)
+        {
+            for (int x = 1; !isFound && (x < atlas.width - 1); ++x)
+            {
+                if (rIsWhiteTexel(atlas, x, y))
+                {
+                    texelX = x;
+                    texelY = y;
+                    isFound = true;
+                }
+            }
+        }
+        if (isFound)
+        {
+            Rectangle texel = { (float)texelX, (float)texelY, 1.0f, 1.0f };
+            glyphs->whiteTexel = texel;
+            glyphs->isWhiteTexelFound = true;
+        }
+        UnloadImage(atlas);
+    }
+    if (!glyphs->isWhiteTexelFound) TRACELOG(LOG_INFO, "RAYTEX: Font atlas has no white texel, rules will be drawn in a separate batch");
+    return glyphs->isWhiteTexelFound ? &glyphs->whiteTexel : NULL;
 }
 
-RayTeX *RayTeXFracNumerator(RayTeX *fracTex)
+void SetRayTeXFontWhiteTexel(Font font, Rectangle texel)
 {
-    if (fracTex->mode != TEXMODE_FRAC) TRACELOG(LOG_WARNING, "RAYTEX: RayTeXFracNumerator() only valid for TEXMODE_FRAC");
-    return fracTex->frac.content[TEX_FRAC_NUMERATOR].ptr;
+    rFontGlyphs *glyphs = rGetFontGlyphs(font);
+    glyphs->whiteTexelTextureId = font.texture.id;
+    glyphs->isWhiteTexelFound = (texel.width > 0.0f) && (texel.height > 0.0f);
+    glyphs->whiteTexel = texel;
 }
 
-RayTeX *RayTeXFracDenominator(RayTeX *fracTex)
+// Draws a quad that samples the middle of the white texel, so that it batches with glyphs from the same atlas
+static void rDrawTexelQuad(Texture2D texture, Rectangle texel, const Vector2 corners[4], Color color)
 {
-    if (fracTex->mode != TEXMODE_FRAC) TRACELOG(LOG_WARNING, "RAYTEX: RayTeXFracDenominator() only valid for TEXMODE_FRAC");
-    return fracTex->frac.content[TEX_FRAC_DENOMINATOR].ptr;
+    float u = (texel.x + texel.width / 2.0f) / (float)texture.width;
+    float v = (texel.y + texel.height / 2.0f) / (float)texture.height;
+
+    rlCheckRenderBatchLimit(4);
+    rlSetTexture(texture.id);
+    rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        for (int i = 0; i < 4; ++i)
+        {
+            rlTexCoord2f(u, v);
+            rlVertex2f(corners[i].x, corners[i].y);
+        }
+    rlEnd();
+    rlSetTexture(0);
 }
 
-RayTeX *RayTeXHorizontalChild(RayTeX *horizontalTex, int index)
+void ClearRayTeXFontCache(void)
 {
-    if (horizontalTex->mode != TEXMODE_HORIZONTAL) TRACELOG(LOG_WARNING, "RAYTEX: RayTeXHorizontalChild() only valid for TEXMODE_HORIZONTAL");
-    if (index < 0)
-    {
-        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXHorizontalChild() index (%i) cannot be negative", index);
-        //index = 0;
-    }
-    int lastChildIndex = horizontalTex->horizontal.elementCount - 1;
-    if (index > lastChildIndex)
-    {
-        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXHorizontalChild() index (%i) cannot be higher than the index of horizontalTex's last child (%i)",
-                 index, lastChildIndex);
-        //index = lastChildIndex;
-    }
-    return horizontalTex->horizontal.content[index].ptr;
+    // Keeps nothing that points at the fonts, including their white texels
+    rClearGlyphCache(&glyphCache);
 }
 
-RayTeX *RayTeXVerticalChild(RayTeX *verticalTex, int index)
+// Layout only reads a font's glyphs, recs and base size, so fonts from LoadRayTeXFontMetrics() measure without a GPU
+// GetFontDefault() has no glyphs before InitWindow(), so that is caught here instead of crashing
+static bool rIsFontMeasurable(rGlyphCache *cache, Font font)
 {
-    if (verticalTex->mode != TEXMODE_VERTICAL) TRACELOG(LOG_WARNING, "RAYTEX: RayTeXVerticalChild() only valid for TEXMODE_VERTICAL");
-    if (index < 0)
+    if ((font.glyphs != NULL) && (font.recs != NULL) && (font.baseSize > 0)) return true;
+
+    if (!cache->isUnmeasurableWarned) TRACELOG(LOG_WARNING, "RAYTEX: Font has no glyph metrics - use LoadRayTeXFontMetrics() to measure without a window");
+    cache->isUnmeasurableWarned = true;
+    return false;
+}
+
+Font LoadRayTeXFontMetrics(const char *fileName, int fontSize, const int *codepoints, int codepointCount)
+{
+    Font font = { 0 };
+    int dataSize = 0;
+    unsigned char *fileData = LoadFileData(fileName, &dataSize);
+    if (fileData == NULL)
     {
-        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXVerticalChild() index (%i) cannot be negative", index);
-        //index = 0;
+        TRACELOG(LOG_WARNING, "RAYTEX: [%s] Failed to load font metrics", fileName);
+        return font;
     }
-    int lastChildIndex = verticalTex->horizontal.elementCount - 1;
-    if (index > lastChildIndex)
+
+    // Same steps as LoadFontEx(), minus uploading the atlas - the recs come from packing the atlas on the CPU
+    font.baseSize = fontSize;
+    font.glyphCount = (codepointCount > 0) ? codepointCount : 95;
+    font.glyphPadding = 4;
+    font.glyphs = LoadFontData(fileData, dataSize, fontSize, (int *)codepoints, codepointCount, FONT_DEFAULT);
+    UnloadFileData(fileData);
+    if (font.glyphs == NULL)
     {
-        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXVerticalChild() index (%i) cannot be higher than the index of verticalTex's last child (%i)",
-                 index, lastChildIndex);
-        //index = lastChildIndex;
+        TRACELOG(LOG_WARNING, "RAYTEX: [%s] Failed to load font metrics", fileName);
+        font.baseSize = 0;
+        font.glyphCount = 0;
+        return font;
+    }
+
+    Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, fontSize, font.glyphPadding, 0);
+
+    // Like LoadFontEx(), replace the glyph bitmaps with slices of the atlas, which carry alpha for RenderRayTeXToImage()
+    for (int i = 0; i < font.glyphCount; ++i)
+    {
+        UnloadImage(font.glyphs[i].image);
+        font.glyphs[i].image = ImageFromImage(atlas, font.recs[i]);
     }
-    return verticalTex->vertical.content[index].ptr;
+    UnloadImage(atlas);
+
+    TRACELOG(LOG_INFO, "RAYTEX: [%s] Font metrics loaded successfully (%i glyphs)", fileName, font.glyphCount);
+    return font;
 }
 
-RayTeX *RayTeXMatrixCell(RayTeX *matrixTex, int rowIndex, int columnIndex)
+void UnloadRayTeXFontMetrics(Font font)
 {
-    if (matrixTex->mode != TEXMODE_MATRIX) TRACELOG(LOG_WARNING, "RAYTEX: RayTeXMatrixCell() only valid for TEXMODE_MATRIX");
+    UnloadFontData(font.glyphs, font.glyphCount);
+    RL_FREE(font.recs);
+}
 
-    if (rowIndex < 0)
+// Same as MeasureTextEx(), for single-line text that is not null-terminated
+static Vector2 rMeasureTextSlice(rGlyphCache *cache, Font font, const char *text, int length, float fontSize, float spacing)
+{
+    Vector2 size = { 0 };
+    if (!rIsFontMeasurable(cache, font)) return size;
+    RAYTEX_STATS_ADD(measureTextCount, 1);
+    rFontGlyphs *glyphs = rGetCachedFontGlyphs(cache, font);
+    float scaleFactor = fontSize / (float)font.baseSize;
+    float width = 0.0f;
+    int codepointCount = 0;
+    for (int i = 0; i < length;)
     {
-        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXMatrixCell() rowIndex (%i) cannot be negative", rowIndex);
-        //rowIndex = 0;
+        int codepointByteCount = 0;
+        int codepoint = GetCodepointNext(&text[i], &codepointByteCount);
+        width += rGlyphAdvance(font, rGetGlyphIndex(font, glyphs, codepoint));
+        i += codepointByteCount;
+        codepointCount++;
     }
-    int lastRowIndex = matrixTex->matrix.rowCount - 1;
-    if (rowIndex > lastRowIndex)
+    if (codepointCount > 0)
     {
-        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXMatrixCell() rowIndex (%i) cannot be higher than the index of matrixTex's last row (%i)",
-                 rowIndex, lastRowIndex);
-        //rowIndex = lastRowIndex;
+        size.x = width*scaleFactor + (float)(codepointCount - 1)*spacing;
+        size.y = fontSize;
     }
+    return size;
+}
 
-    if (columnIndex < 0)
-    {
-        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXMatrixCell() columnIndex (%i) cannot be negative", columnIndex);
-        //columnIndex = 0;
-    }
-    int lastColumnIndex = matrixTex->matrix.columnCount - 1;
-    if (columnIndex > lastColumnIndex)
+// Same as DrawTextEx(), for single-line text that is not null-terminated
+static void rDrawTextSlice(Font font, const char *text, int length, Vector2 position, float fontSize, float spacing, Color tint)
+{
+    rFontGlyphs *glyphs = rGetFontGlyphs(font);
+    float scaleFactor = fontSize / (float)font.baseSize;
+    float textOffsetX = 0.0f;
+    for (int i = 0; i < length;)
     {
-        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXMatrixCell() columnIndex (%i) cannot be higher than the index of matrixTex's last column (%i)",
-                 columnIndex, lastColumnIndex);
-        //columnIndex = lastColumnIndex;
+        int codepointByteCount = 0;
+        int codepoint = GetCodepointNext(&text[i], &codepointByteCount);
+        int index = rGetGlyphIndex(font, glyphs, codepoint);
+        if ((codepoint != ' ') && (codepoint != '\t'))
+        {
+            Vector2 glyphPosition = { position.x + textOffsetX, position.y };
+            rDrawGlyph(font, index, glyphPosition, fontSize, tint);
+        }
+        textOffsetX += rGlyphDrawAdvance(font, index)*scaleFactor + spacing;
+        i += codepointByteCount;
     }
-
-    return matrixTex->matrix.content[rowIndex * matrixTex->matrix.columnCount + columnIndex].ptr;
 }
 
-RayTeX GenRayTeXSpace(int mu)
+// Child arrays and owned text start with a count of the elements holding them, so that CloneRayTeX() only takes
+// another reference. An element gets its own copy before it writes to one that is shared.
+typedef union rSharedHeader {
+    int refCount;
+    void *alignment; // Keeps the child references after the header aligned
+} rSharedHeader;
+
+static void *rAllocShared(size_t size)
 {
-    RayTeX element = { 0 };
-    element.mode = TEXMODE_SPACE;
-    element.space.size = mu;
-    TRACELOG(LOG_INFO, "RAYTEX: TeX %i mu horizontal space element generated successfully", mu);
-    return element;
+    rSharedHeader *header = RAYTEX_MALLOC(sizeof(rSharedHeader) + size);
+    if (header == NULL) return NULL;
+    header->refCount = 1;
+    return header + 1;
 }
 
-RayTeX GenRayTeXVSpace(int mu)
+static rSharedHeader *rGetSharedHeader(const void *memory)
 {
-    RayTeX element = { 0 };
-    element.mode = TEXMODE_VSPACE;
-    element.space.size = mu;
-    TRACELOG(LOG_INFO, "RAYTEX: TeX %i mu vertical space element generated successfully", mu);
-    return element;
+    return (rSharedHeader *)memory - 1;
+}
+
+static bool rIsShared(const void *memory)
+{
+    return (memory != NULL) && (rGetSharedHeader(memory)->refCount > 1);
+}
+
+static void rReleaseShared(const void *memory)
+{
+    if ((memory != NULL) && (--rGetSharedHeader(memory)->refCount == 0)) RAYTEX_FREE(rGetSharedHeader(memory));
+}
+
+// Short formatted text lives in the element itself, so it has to be found again after every copy of the element
+static const char *rTextContent(const RayTeX *tex)
+{
+    return tex->text.isInline ? tex->text.inlineContent : tex->text.content;
+}
+
+// Number of bytes of a text element's content
+static int rTextLength(const RayTeX *tex)
+{
+    return (tex->text.length > 0) ? tex->text.length : (int)strlen(rTextContent(tex));
+}
+
+// Shaping results are kept ahead of the decoded buffers rather than in the element, so that copies of a text root
+// passed by value find them again
+typedef struct rTextShaping {
+    const void *fontId; // Font the glyph run was shaped for
+    float advance;      // Sum of glyph advances at the font's base size
+} rTextShaping;
+
+static rTextShaping *rGetTextShaping(const RayTeX *tex)
+{
+    return (tex->text.codepoints != NULL) ? (rTextShaping *)tex->text.codepoints - 1 : NULL;
+}
+
+static bool rIsTextShapedFor(const RayTeX *tex, const void *fontId)
+{
+    return (tex->text.codepoints != NULL) && (rGetTextShaping(tex)->fontId == fontId);
+}
+
+static void rFreeRayTeXTextBuffers(RayTeX *tex)
+{
+    RAYTEX_FREE(rGetTextShaping(tex));
+    tex->text.codepoints = NULL;
+}
+
+// Decodes a text element's content, and makes room for shaping it into a glyph run.
+// The buffers are reused when the text changes but still fits in them, and are sized for any inline text from the start.
+static void rDecodeRayTeXText(RayTeX *tex)
+{
+    const char *content = rTextContent(tex);
+    int length = rTextLength(tex);
+    // Counted with the same walk that decodes, since invalid bytes decode to one codepoint each
+    int codepointCount = 0;
+    for (int i = 0; i < length; ++codepointCount)
+    {
+        int codepointByteCount = 0;
+        GetCodepointNext(&content[i], &codepointByteCount);
+        i += codepointByteCount;
+    }
+    tex->text.codepointCount = 0;
+    if (codepointCount == 0) return;
+
+    if ((tex->text.codepoints == NULL) || (codepointCount > tex->text.codepointCapacity))
+    {
+        int capacity = (tex->text.isInline && (codepointCount < RAYTEX_INLINE_TEXT_SIZE - 1)) ? RAYTEX_INLINE_TEXT_SIZE - 1 : codepointCount;
+        rFreeRayTeXTextBuffers(tex);
+        tex->text.codepointCapacity = 0;
+        rTextShaping *shaping = RAYTEX_MALLOC(sizeof(rTextShaping) + capacity*(2*sizeof(int) + sizeof(float)));
+        if (shaping == NULL)
+        {
+            TRACELOG(LOG_WARNING, "RAYTEX: Failed to allocate codepoints, text will be decoded on every measure");
+            return;
+        }
+        tex->text.codepoints = (int *)(shaping + 1);
+        tex->text.codepointCapacity = capacity;
+        tex->text.glyphIndices = tex->text.codepoints + capacity;
+        tex->text.glyphOffsets = (float *)(tex->text.glyphIndices + capacity);
+    }
+
+    rGetTextShaping(tex)->fontId = NULL;
+    codepointCount = 0;
+    for (int i = 0; i < length;)
+    {
+        int codepointByteCount = 0;
+        tex->text.codepoints[codepointCount++] = GetCodepointNext(&content[i], &codepointByteCount);
+        i += codepointByteCount;
+    }
+    tex->text.codepointCount = codepointCount;
+}
+
+// Formats into the element's own storage: inline when the result is short, otherwise an owned buffer that only grows
+static bool rFormatRayTeXText(RayTeX *tex, const char *fmt, va_list args)
+{
+    // Text shared with a clone is left to it
+    if (tex->text.isOwned && rIsShared(tex->text.content))
+    {
+        rReleaseShared(tex->text.content);
+        tex->text.isOwned = false;
+        tex->text.isInline = true;
+        tex->text.inlineContent[0] = '\0';
+    }
+
+    va_list retryArgs;
+    va_copy(retryArgs, args);
+    char *buffer = tex->text.isOwned ? (char *)tex->text.content : tex->text.inlineContent;
+    int capacity = tex->text.isOwned ? tex->text.capacity : RAYTEX_INLINE_TEXT_SIZE;
+    int length = vsnprintf(buffer, capacity, fmt, args);
+    bool isFormatted = (length >= 0);
+    if (isFormatted && (length >= capacity))
+    {
+        int size = (length + 1 > 2*capacity) ? length + 1 : 2*capacity;
+        char *memory = rAllocShared(size);
+        isFormatted = (memory != NULL);
+        if (isFormatted)
+        {
+            vsnprintf(memory, size, fmt, retryArgs);
+            if (tex->text.isOwned) rReleaseShared(tex->text.content);
+            tex->text.isOwned = true;
+            tex->text.content = memory;
+            tex->text.capacity = size;
+        }
+        else TRACELOG(LOG_ERROR, "RAYTEX: Failed to allocate %i bytes of text", size);
+    }
+    va_end(retryArgs);
+    if (!isFormatted) return false;
+
+    tex->text.isInline = !tex->text.isOwned;
+    if (tex->text.isInline) tex->text.content = NULL;
+    tex->text.length = 0;
+    return true;
+}
+
+// Looks up every glyph of a text element once per font, so that drawing does not have to
+static void rShapeRayTeXText(rGlyphCache *cache, const Font *font, RayTeX *tex)
+{
+    RAYTEX_STATS_ADD(measureTextCount, 1);
+    rFontGlyphs *glyphs = rGetCachedFontGlyphs(cache, *font);
+    float advance = 0.0f;
+    float offset = 0.0f;
+    for (int i = 0; i < tex->text.codepointCount; ++i)
+    {
+        int codepoint = tex->text.codepoints[i];
+        int index = rGetGlyphIndex(*font, glyphs, codepoint);
+        tex->text.glyphIndices[i] = ((codepoint != ' ') && (codepoint != '\t')) ? index : -1;
+        tex->text.glyphOffsets[i] = offset;
+        advance += rGlyphAdvance(*font, index);
+        offset += rGlyphDrawAdvance(*font, index);
+    }
+    rTextShaping *shaping = rGetTextShaping(tex);
+    shaping->advance = advance;
+    shaping->fontId = font->glyphs;
+}
+
+// Must match hash_name() in tools/gen_raytex_symbols.py
+static unsigned int rHashSymbolName(const char *name, int length, unsigned int seed)
+{
+    unsigned int hash = 2166136261u ^ seed;
+    for (int i = 0; i < length; ++i)
+    {
+        hash ^= (unsigned char)name[i];
+        hash *= 16777619u;
+    }
+    hash ^= hash >> 16;
+    return hash;
+}
+
+// One hash and one compare, however many symbols there are
+static RayTeXSymbol rRayTeXSymbolFromName(const char *name, int length)
+{
+    unsigned int slot = rHashSymbolName(name, length, SYMBOL_HASH_SEED) & (SYMBOL_HASH_TABLE_SIZE - 1);
+    int nameIndex = (int)symbolHashSlots[slot] - 1;
+    if ((nameIndex >= 0) && (strncmp(symbolNames[nameIndex], name, length) == 0) && (symbolNames[nameIndex][length] == '\0'))
+    {
+        return symbolNameValues[nameIndex];
+    }
+
+    TRACELOG(LOG_WARNING, "RAYTEX: Unknown symbol \"%.*s\"", length, name);
+    return TEXSYMBOL_UNKNOWN;
+}
+
+RayTeXSymbol RayTeXSymbolFromName(const char *name)
+{
+    return rRayTeXSymbolFromName(name, (int)strlen(name));
+}
+
+int GetRayTeXSymbolCodepoint(RayTeXSymbol symbol)
+{
+    if ((symbol < 0) || (symbol >= TEXSYMBOL_COUNT)) return 0;
+    return symbolCodepoints[symbol];
+}
+
+// Encodes a codepoint as UTF-8, returning the number of bytes
+static int rEncodeCodepoint(int codepoint, char *utf8)
+{
+    if (codepoint < 0x80)
+    {
+        utf8[0] = (char)codepoint;
+        return 1;
+    }
+    if (codepoint < 0x800)
+    {
+        utf8[0] = (char)(0xC0 | (codepoint >> 6));
+        utf8[1] = (char)(0x80 | (codepoint & 0x3F));
+        return 2;
+    }
+    if (codepoint < 0x10000)
+    {
+        utf8[0] = (char)(0xE0 | (codepoint >> 12));
+        utf8[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        utf8[2] = (char)(0x80 | (codepoint & 0x3F));
+        return 3;
+    }
+    utf8[0] = (char)(0xF0 | (codepoint >> 18));
+    utf8[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+    utf8[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+    utf8[3] = (char)(0x80 | (codepoint & 0x3F));
+    return 4;
+}
+
+// Space on each side of a symbol, depending on its class
+static float rSymbolSpace(RayTeXSymbol symbol, float fontSize)
+{
+    switch (symbolClasses[symbol])
+    {
+    case TEXSYMBOLCLASS_OP:  return MU_TO_PIXELS((float)THINSPACE_SIZE, fontSize);
+    case TEXSYMBOLCLASS_BIN: return MU_TO_PIXELS((float)BINSPACE_SIZE, fontSize);
+    case TEXSYMBOLCLASS_REL: return MU_TO_PIXELS((float)RELSPACE_SIZE, fontSize);
+    default: return 0.0f;
+    }
+}
+
+// Fonts without a glyph for the symbol get the one GetGlyphIndex() falls back to
+static bool rHasSymbolGlyph(const Font *font, int index, RayTeXSymbol symbol)
+{
+    return (font->glyphs != NULL) && (font->glyphCount > 0) && (font->glyphs[index].value == symbolCodepoints[symbol]);
+}
+
+// \neq is drawn as an equals sign with a slash over it in fonts that have no glyph for it
+static Vector2 rMeasureSymbol(rGlyphCache *cache, Font font, RayTeXSymbol symbol, float fontSize)
+{
+    Vector2 size = { 0 };
+    if (!rIsFontMeasurable(cache, font)) return size;
+    if ((symbol < 0) || (symbol >= TEXSYMBOL_COUNT))
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: Unknown symbol [%i]", symbol);
+        return size;
+    }
+
+    char utf8[4] = { 0 };
+    int length = rEncodeCodepoint(symbolCodepoints[symbol], utf8);
+    if ((symbol == TEXSYMBOL_NEQ) && !rHasSymbolGlyph(&font, rGetGlyphIndex(font, rGetCachedFontGlyphs(cache, font), symbolCodepoints[symbol]), symbol))
+    {
+        length = 1;
+        utf8[0] = '=';
+    }
+
+    Vector2 glyphSize = rMeasureTextSlice(cache, font, utf8, length, fontSize, fontSize / 10);
+    size.x = glyphSize.x + rSymbolSpace(symbol, fontSize)*2.0f;
+    size.y = glyphSize.y;
+    return size;
+}
+
+Vector2 MeasureRayTeXSymbolEx(Font font, RayTeXSymbol symbol, float fontSize)
+{
+    return rMeasureSymbol(&glyphCache, font, symbol, fontSize);
+}
+
+int MeasureRayTeXSymbolWidth(RayTeXSymbol symbol, int fontSize)
+{
+    return (int)MeasureRayTeXSymbolEx(GetFontDefault(), symbol, (float)fontSize).x;
+}
+
+int MeasureRayTeXSymbolHeight(RayTeXSymbol symbol, int fontSize)
+{
+    return (int)MeasureRayTeXSymbolEx(GetFontDefault(), symbol, (float)fontSize).y;
+}
+
+// Receives the primitives that make up a drawn element, so that the same walk can draw, record, or count them
+// Color is NULL for primitives that inherit the color passed in when drawing
+typedef struct rDrawSink {
+    void *userData;
+    void (*DrawText)(void *userData, const Font *font, const char *text, int length, Vector2 position, float fontSize, const Color *color);
+    void (*DrawGlyphRun)(void *userData, const Font *font, const int *glyphIndices, const float *glyphOffsets, int glyphCount, Vector2 position, float fontSize, const Color *color); // NULL to receive DrawText() instead
+    void (*DrawRule)(void *userData, const Font *font, Rectangle rec, const Color *color);
+    void (*DrawLine)(void *userData, const Font *font, Vector2 startPos, Vector2 endPos, const Color *color);
+} rDrawSink;
+
+// Glyphs, rules and lines are all drawn as quads from the font's atlas, so a formula usually fits in one batch
+static void rRaylibDrawText(void *userData, const Font *font, const char *text, int length, Vector2 position, float fontSize, const Color *color)
+{
+    if (length == 0) length = (int)strlen(text);
+    RAYTEX_STATS_ADD(drawTextCount, 1);
+    rDrawTextSlice(*font, text, length, position, fontSize, fontSize / 10, *color);
+}
+
+// Glyph offsets are at the font's base size and do not include spacing, so one run serves every font size
+static void rRaylibDrawGlyphRun(void *userData, const Font *font, const int *glyphIndices, const float *glyphOffsets, int glyphCount, Vector2 position, float fontSize, const Color *color)
+{
+    RAYTEX_STATS_ADD(drawTextCount, 1);
+    float scaleFactor = fontSize / (float)font->baseSize;
+    float spacing = fontSize / 10;
+    for (int i = 0; i < glyphCount; ++i)
+    {
+        if (glyphIndices[i] < 0) continue;
+        Vector2 glyphPosition = { position.x + glyphOffsets[i]*scaleFactor + (float)i*spacing, position.y };
+        rDrawGlyph(*font, glyphIndices[i], glyphPosition, fontSize, *color);
+    }
+}
+
+static void rRaylibDrawRule(void *userData, const Font *font, Rectangle rec, const Color *color)
+{
+    const Rectangle *texel = rGetWhiteTexel(*font);
+    if (texel == NULL)
+    {
+        DrawRectangleRec(rec, *color);
+        return;
+    }
+
+    Vector2 corners[4] = {
+        { rec.x, rec.y },
+        { rec.x, rec.y + rec.height },
+        { rec.x + rec.width, rec.y + rec.height },
+        { rec.x + rec.width, rec.y },
+    };
+    rDrawTexelQuad(font->texture, *texel, corners, *color);
+}
+
+static void rRaylibDrawLine(void *userData, const Font *font, Vector2 startPos, Vector2 endPos, const Color *color)
+{
+    const Rectangle *texel = rGetWhiteTexel(*font);
+    float dx = endPos.x - startPos.x;
+    float dy = endPos.y - startPos.y;
+    float length = sqrtf(dx*dx + dy*dy);
+    if ((texel == NULL) || (length == 0.0f))
+    {
+        DrawLineV(startPos, endPos, *color);
+        return;
+    }
+
+    // One pixel wide, like DrawLineV()
+    float nx = -dy / length*0.5f;
+    float ny = dx / length*0.5f;
+    Vector2 corners[4] = {
+        { startPos.x - nx, startPos.y - ny },
+        { startPos.x + nx, startPos.y + ny },
+        { endPos.x + nx, endPos.y + ny },
+        { endPos.x - nx, endPos.y - ny },
+    };
+    rDrawTexelQuad(font->texture, *texel, corners, *color);
+}
+
+static const rDrawSink raylibDrawSink = { NULL, rRaylibDrawText, rRaylibDrawGlyphRun, rRaylibDrawRule, rRaylibDrawLine };
+
+// Size is the symbol's measured size, passed in so that drawing does not measure
+static void rDrawRayTeXSymbol(const rDrawSink *sink, const Font *font, RayTeXSymbol symbol, Vector2 position, Vector2 size, float fontSize, const Color *color)
+{
+    if ((symbol < 0) || (symbol >= TEXSYMBOL_COUNT))
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: Unknown symbol [%i]", symbol);
+        return;
+    }
+
+    float space = rSymbolSpace(symbol, fontSize);
+    Vector2 positionWithSpace = { 0 };
+    positionWithSpace.x = position.x + space;
+    positionWithSpace.y = position.y;
+
+    // Todo: Implement these with textures or a custom font at some point
+    if ((symbol == TEXSYMBOL_NEQ) && !rHasSymbolGlyph(font, GetGlyphIndex(*font, symbolCodepoints[symbol]), symbol))
+    {
+        sink->DrawText(sink->userData, font, "=", 0, positionWithSpace, fontSize, color);
+
+        Vector2 crossBottomLeft = { position.x + space, position.y + size.y };
+        Vector2 crossTopRight = { position.x + size.x - space, position.y };
+        sink->DrawLine(sink->userData, font, crossBottomLeft, crossTopRight, color);
+    }
+    else
+    {
+        char utf8[4] = { 0 };
+        int length = rEncodeCodepoint(symbolCodepoints[symbol], utf8);
+        sink->DrawText(sink->userData, font, utf8, length, positionWithSpace, fontSize, color);
+    }
+}
+
+void DrawRayTeXSymbolEx(Font font, RayTeXSymbol symbol, Vector2 position, float fontSize, Color color)
+{
+    rDrawRayTeXSymbol(&raylibDrawSink, &font, symbol, position, MeasureRayTeXSymbolEx(font, symbol, fontSize), fontSize, &color);
+}
+
+void DrawRayTeXSymbol(RayTeXSymbol symbol, int x, int y, int fontSize, Color color)
+{
+    Vector2 position = { 0 };
+    position.x = (float)x;
+    position.y = (float)y;
+    DrawRayTeXSymbolEx(GetFontDefault(), symbol, position, (float)fontSize, color);
+}
+
+// Text and symbols sit centered on the math axis
+static RayTeXBox rTextBox(rGlyphCache *cache, const Font *font, const char *text, int length, float fontSize)
+{
+    if (length == 0) length = (int)strlen(text);
+    Vector2 size = rMeasureTextSlice(cache, *font, text, length, fontSize, fontSize / 10);
+    RayTeXBox box = { 0 };
+    box.width = size.x;
+    box.height = size.y / 2.0f;
+    box.depth = size.y / 2.0f;
+    return box;
+}
+
+// Same as rTextBox(), but reuses the element's decoded codepoints and the advance summed for the last font
+static RayTeXBox rTextElementBox(rGlyphCache *cache, const Font *font, RayTeX *tex, float fontSize)
+{
+    RayTeXBox box = { 0 };
+    if (!rIsFontMeasurable(cache, *font)) return box;
+    if (tex->text.codepoints == NULL)
+    {
+        // Nothing was decoded, because the text is empty or its buffers could not be allocated
+        if (rTextContent(tex)[0] != '\0') box = rTextBox(cache, font, rTextContent(tex), tex->text.length, fontSize);
+        return box;
+    }
+    if (!rIsTextShapedFor(tex, font->glyphs)) rShapeRayTeXText(cache, font, tex);
+
+    if (tex->text.codepointCount > 0)
+    {
+        box.width = rGetTextShaping(tex)->advance*fontSize / (float)font->baseSize + (float)(tex->text.codepointCount - 1)*(fontSize / 10);
+        box.height = fontSize / 2.0f;
+        box.depth = fontSize / 2.0f;
+    }
+    return box;
+}
+
+// Matrices are spaced like TeX's matrix environment, with the whole table centered on the math axis
+static RayTeXBox rMatrixBox(int rowCount, int columnCount, const float *columnWidths, const float *rowHeights, const float *rowDepths, float fontSize)
+{
+    RayTeXBox box = { 0 };
+    if ((rowCount == 0) || (columnCount == 0)) return box;
+
+    for (int column = 0; column < columnCount; ++column) box.width += columnWidths[column];
+    box.width += (float)(columnCount - 1)*MU_TO_PIXELS((float)TEXMATRIX_COLUMN_SPACING, fontSize);
+
+    float totalHeight = (float)(rowCount - 1)*MU_TO_PIXELS((float)TEXMATRIX_ROW_SPACING, fontSize);
+    for (int row = 0; row < rowCount; ++row) totalHeight += rowHeights[row] + rowDepths[row];
+    box.height = totalHeight / 2.0f;
+    box.depth = totalHeight / 2.0f;
+    return box;
+}
+
+static RayTeXBox rSymbolBox(rGlyphCache *cache, const Font *font, RayTeXSymbol symbol, float fontSize)
+{
+    Vector2 size = rMeasureSymbol(cache, *font, symbol, fontSize);
+    RayTeXBox box = { 0 };
+    box.width = size.x;
+    box.height = size.y / 2.0f;
+    box.depth = size.y / 2.0f;
+    return box;
+}
+
+// The rule is centered on the math axis
+static RayTeXBox rFracBox(RayTeXBox numeratorBox, RayTeXBox denominatorBox, float fontSize, Vector2 offsets[2])
+{
+    float spacing = MU_TO_PIXELS((float)TEXFRAC_SPACING, fontSize);
+    float thickness = MU_TO_PIXELS((float)TEXFRAC_THICKNESS, fontSize);
+    RayTeXBox box = { 0 };
+    box.width = (numeratorBox.width > denominatorBox.width ? numeratorBox.width : denominatorBox.width) + MU_TO_PIXELS(TEXFRAC_OVERHANG*2.0f, fontSize);
+    box.height = numeratorBox.height + numeratorBox.depth + spacing + thickness / 2.0f;
+    box.depth = thickness / 2.0f + spacing + denominatorBox.height + denominatorBox.depth;
+
+    offsets[TEX_FRAC_NUMERATOR].x = (box.width - numeratorBox.width) / 2.0f;
+    offsets[TEX_FRAC_NUMERATOR].y = 0.0f;
+    offsets[TEX_FRAC_DENOMINATOR].x = (box.width - denominatorBox.width) / 2.0f;
+    offsets[TEX_FRAC_DENOMINATOR].y = box.height + thickness / 2.0f + spacing;
+    return box;
+}
+
+static Rectangle rFracRule(RayTeXBox box, Vector2 position, float fontSize)
+{
+    Rectangle ruleRec = { 0 };
+    ruleRec.x = position.x;
+    ruleRec.height = MU_TO_PIXELS((float)TEXFRAC_THICKNESS, fontSize);
+    ruleRec.y = position.y + box.height - ruleRec.height / 2.0f;
+    ruleRec.width = box.width;
+    return ruleRec;
+}
+
+static int rGetProcessorCount(void)
+{
+#if defined(_WIN32)
+    int count = (int)GetActiveProcessorCount(0xFFFF); // ALL_PROCESSOR_GROUPS
+#else
+    int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return (count > 0) ? count : 1;
+}
+
+static bool rLayoutRayTeX(rGlyphCache *cache, const Font *font, RayTeX *tex, float fontSize);
+
+#if defined(RAYTEX_THREADS)
+typedef struct rLayoutPool rLayoutPool;
+
+// Set while the thread works for a layout pool, whose items never start a pool of their own
+static _Thread_local bool isLayoutWorker = false;
+
+// Lays out item `index` of a pool's work with the worker's glyph cache, and returns true if its layout changed
+typedef bool (*rLayoutPoolItem)(rGlyphCache *cache, void *userData, int index);
+
+// Each worker owns a range of items, and other workers steal from its back once they run out of their own
+typedef struct rLayoutWorker {
+    rLayoutPool *pool;
+    mtx_t lock; // Guards begin and end
+    int begin;
+    int end;
+    rGlyphCache *glyphCache;
+    bool isChanged;
+#if defined(RAYTEX_STATS)
+    RayTeXStats stats;
+#endif
+} rLayoutWorker;
+
+struct rLayoutPool {
+    rLayoutPoolItem LayoutItem;
+    void *userData;
+    int workerCount;
+    rLayoutWorker *workers;
+};
+
+// Takes the next few items from the worker's own range, or steals half of what another worker has left
+// Stealing keeps every core busy when some rows cost far more than others. No work is added once the pool starts,
+// so a worker that finds every range empty is done.
+static bool rTakeLayoutWork(rLayoutWorker *worker, int *begin, int *end)
+{
+    mtx_lock(&worker->lock);
+    *begin = worker->begin;
+    *end = (worker->end - worker->begin > RAYTEX_PARALLEL_LAYOUT_GRAIN) ? worker->begin + RAYTEX_PARALLEL_LAYOUT_GRAIN : worker->end;
+    worker->begin = *end;
+    mtx_unlock(&worker->lock);
+    if (*begin < *end) return true;
+
+    rLayoutPool *pool = worker->pool;
+    int workerIndex = (int)(worker - pool->workers);
+    for (int i = 1; i < pool->workerCount; ++i)
+    {
+        rLayoutWorker *victim = &pool->workers[(workerIndex + i) % pool->workerCount];
+        mtx_lock(&victim->lock);
+        int remaining = victim->end - victim->begin;
+        int stolenCount = (remaining > RAYTEX_PARALLEL_LAYOUT_GRAIN) ? remaining / 2 : remaining;
+        victim->end -= stolenCount;
+        int stolenBegin = victim->end;
+        mtx_unlock(&victim->lock);
+        if (stolenCount == 0) continue;
+
+        // Start on the first few and leave the rest where others can steal them
+        *begin = stolenBegin;
+        *end = (stolenCount > RAYTEX_PARALLEL_LAYOUT_GRAIN) ? stolenBegin + RAYTEX_PARALLEL_LAYOUT_GRAIN : stolenBegin + stolenCount;
+        mtx_lock(&worker->lock);
+        worker->begin = *end;
+        worker->end = stolenBegin + stolenCount;
+        mtx_unlock(&worker->lock);
+        return true;
+    }
+    return false;
+}
+
+static int rLayoutWorkerRun(void *arg)
+{
+    rLayoutWorker *worker = arg;
+    rLayoutPool *pool = worker->pool;
+    bool wasLayoutWorker = isLayoutWorker;
+    isLayoutWorker = true;
+#if defined(RAYTEX_STATS)
+    RayTeXStats *previousStats = threadStats;
+    threadStats = &worker->stats;
+#endif
+    int begin = 0;
+    int end = 0;
+    while (rTakeLayoutWork(worker, &begin, &end))
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            if (pool->LayoutItem(worker->glyphCache, pool->userData, i)) worker->isChanged = true;
+        }
+    }
+#if defined(RAYTEX_STATS)
+    threadStats = previousStats;
+#endif
+    isLayoutWorker = wasLayoutWorker;
+    return 0;
+}
+
+// Items share nothing but the font, so each worker lays out whole subtrees with its own glyph cache.
+// Returns false without laying anything out if there is too little work to split or the pool could not be set up.
+static bool rRunLayoutPool(int itemCount, rLayoutPoolItem LayoutItem, void *userData, bool *isChanged)
+{
+    int workerCount = rGetProcessorCount();
+    if (workerCount > itemCount / RAYTEX_PARALLEL_LAYOUT_GRAIN) workerCount = itemCount / RAYTEX_PARALLEL_LAYOUT_GRAIN;
+    if (workerCount < 2) return false;
+
+    rLayoutWorker *workers = RL_CALLOC(workerCount, sizeof(rLayoutWorker));
+    rGlyphCache *glyphCaches = RL_CALLOC(workerCount, sizeof(rGlyphCache));
+    thrd_t *threads = RL_MALLOC((workerCount - 1)*sizeof(thrd_t));
+    if ((workers == NULL) || (glyphCaches == NULL) || (threads == NULL))
+    {
+        RL_FREE(workers);
+        RL_FREE(glyphCaches);
+        RL_FREE(threads);
+        return false;
+    }
+
+    rLayoutPool pool = { LayoutItem, userData, workerCount, workers };
+    for (int i = 0; i < workerCount; ++i)
+    {
+        workers[i].pool = &pool;
+        mtx_init(&workers[i].lock, mtx_plain);
+        workers[i].begin = (int)((long long)itemCount*i / workerCount);
+        workers[i].end = (int)((long long)itemCount*(i + 1) / workerCount);
+        workers[i].glyphCache = &glyphCaches[i];
+    }
+
+    // The calling thread works as worker 0. If a thread fails to start, the others steal its share.
+    int startedCount = 0;
+    for (int i = 1; i < workerCount; ++i)
+    {
+        if (thrd_create(&threads[startedCount], rLayoutWorkerRun, &workers[i]) == thrd_success) startedCount++;
+    }
+    rLayoutWorkerRun(&workers[0]);
+    for (int i = 0; i < startedCount; ++i) thrd_join(threads[i], NULL);
+
+    for (int i = 0; i < workerCount; ++i)
+    {
+        if (workers[i].isChanged) *isChanged = true;
+#if defined(RAYTEX_STATS)
+        rAddStats(&stats, &workers[i].stats);
+#endif
+        mtx_destroy(&workers[i].lock);
+        rClearGlyphCache(&glyphCaches[i]);
+    }
+    RL_FREE(workers);
+    RL_FREE(glyphCaches);
+    RL_FREE(threads);
+    return true;
+}
+
+typedef struct rLayoutChildren {
+    const Font *font;
+    RayTeXRef *children;
+    float fontSize;
+} rLayoutChildren;
+
+static bool rLayoutChildrenItem(rGlyphCache *cache, void *userData, int index)
+{
+    rLayoutChildren *children = userData;
+    return rLayoutRayTeX(cache, children->font, children->children[index].ptr, children->fontSize);
+}
+#endif
+
+// Children are split across threads only when most of them are expected to need work, see rLayoutRayTeX()
+static bool rLayoutRayTeXChildren(rGlyphCache *cache, const Font *font, RayTeXRef *children, int childCount, float fontSize, bool isSplittable)
+{
+    bool isChanged = false;
+#if defined(RAYTEX_THREADS)
+    // Only threads outside a pool split work, so large containers nested inside a worker's subtree stay on that worker
+    if ((RAYTEX_PARALLEL_LAYOUT_THRESHOLD > 0) && (childCount >= RAYTEX_PARALLEL_LAYOUT_THRESHOLD) && !isLayoutWorker && isSplittable)
+    {
+        rLayoutChildren work = { font, children, fontSize };
+        if (rRunLayoutPool(childCount, rLayoutChildrenItem, &work, &isChanged)) return isChanged;
+    }
+#endif
+
+    for (int i = 0; i < childCount; ++i)
+    {
+        if (rLayoutRayTeX(cache, font, children[i].ptr, fontSize)) isChanged = true;
+    }
+    return isChanged;
+}
+
+// Returns the element's children, and where layout stores their offsets
+static RayTeXRef *rGetRayTeXChildren(const RayTeX *tex, int *count, Vector2 **offsets)
+{
+    switch (tex->mode)
+    {
+    case TEXMODE_FRAC:
+        *count = 2;
+        *offsets = (Vector2 *)tex->frac.offsets;
+        return (RayTeXRef *)tex->frac.content;
+
+    case TEXMODE_HORIZONTAL:
+        *count = tex->horizontal.elementCount;
+        *offsets = tex->horizontal.offsets;
+        return tex->horizontal.content;
+
+    case TEXMODE_VERTICAL:
+        *count = tex->vertical.elementCount;
+        *offsets = tex->vertical.offsets;
+        return tex->vertical.content;
+
+    case TEXMODE_MATRIX:
+        *count = tex->matrix.rowCount*tex->matrix.columnCount;
+        *offsets = tex->matrix.offsets;
+        return tex->matrix.content;
+
+    default:
+        *count = 0;
+        *offsets = NULL;
+        return NULL;
+    }
+}
+
+// Scale-free layouts are computed once for a font size of 1 and hold for every font size
+static bool rIsLayoutFor(const RayTeXLayout *layout, const void *fontId, float fontSize)
+{
+    return (layout->fontId == fontId) && (layout->isScaleFree || (layout->fontSize == fontSize));
+}
+
+// Pixels per unit of the element's layout, for the font size it inherits
+static float rGetLayoutScale(const RayTeX *tex, float fontSize)
+{
+    if (tex->isOverridingFontSize) fontSize = (float)tex->overrideFontSize;
+    return tex->layout.isScaleFree ? fontSize : 1.0f;
+}
+
+static RayTeXBox rScaleBox(RayTeXBox box, float scale)
+{
+    box.width *= scale;
+    box.height *= scale;
+    box.depth *= scale;
+    return box;
+}
+
+// Element's box in pixels for the font size it inherits, or in units of it when that is 1
+static RayTeXBox rGetLayoutBox(const RayTeX *tex, float fontSize)
+{
+    return rScaleBox(tex->layout.box, rGetLayoutScale(tex, fontSize));
+}
+
+// Layout of an interned element for a font and font size other than the one it currently holds
+typedef struct rSharedLayout {
+    const void *fontId;
+    float fontSize;
+    bool isScaleFree;
+    RayTeXBox box;
+    unsigned int version;
+    unsigned int childVersions;
+    Vector2 *offsets; // One per child
+} rSharedLayout;
+
+struct RayTeXSharedLayouts {
+    int count;
+    int next;                 // Replaced next once all are used
+    unsigned int lastVersion; // Highest version any of the element's layouts had, kept when the layouts are dropped
+    rSharedLayout layouts[MAX_SHARED_LAYOUTS];
+};
+
+// Edits to laid out elements whose parent is unknown, which could be below anything. Layout visits every element
+// once after such an edit, instead of only those marked on the way up from the edited one.
+// Only edits write it, and those are never made while layout runs, so layout workers only read it. Starting a worker
+// orders its reads after every edit made before.
+static unsigned int unlinkedEditCount = 0;
+
+static rSharedLayout *rFindSharedLayout(const RayTeX *tex, const void *fontId, float fontSize)
+{
+    struct RayTeXSharedLayouts *shared = tex->layout.sharedLayouts;
+    if (shared == NULL) return NULL;
+    for (int i = 0; i < shared->count; ++i)
+    {
+        if ((shared->layouts[i].fontId == fontId) && (shared->layouts[i].isScaleFree || (shared->layouts[i].fontSize == fontSize))) return &shared->layouts[i];
+    }
+    return NULL;
+}
+
+// Interned elements are reached from parents with different fonts and font sizes. Instead of laying them out again
+// each time they are reached from another one, the current layout is kept aside and the one asked for is brought back.
+static void rSwapSharedLayout(RayTeX *tex, const void *fontId, float fontSize)
+{
+    if (tex->layout.isValid && rIsLayoutFor(&tex->layout, fontId, fontSize)) return;
+
+    int childCount = 0;
+    Vector2 *offsets = NULL;
+    rGetRayTeXChildren(tex, &childCount, &offsets);
+    struct RayTeXSharedLayouts *shared = tex->layout.sharedLayouts;
+    if (tex->layout.isValid)
+    {
+        if (shared == NULL)
+        {
+            // Every kept layout gets its offsets from the same allocation
+            shared = RL_CALLOC(1, sizeof(struct RayTeXSharedLayouts) + MAX_SHARED_LAYOUTS*childCount*sizeof(Vector2));
+            if (shared == NULL) return;
+            Vector2 *keptOffsets = (Vector2 *)(shared + 1);
+            for (int i = 0; i < MAX_SHARED_LAYOUTS; ++i) shared->layouts[i].offsets = keptOffsets + i*childCount;
+            shared->lastVersion = tex->layout.version;
+            tex->layout.sharedLayouts = shared;
+        }
+
+        rSharedLayout *kept = rFindSharedLayout(tex, tex->layout.fontId, tex->layout.fontSize);
+        if (kept == NULL)
+        {
+            if (shared->count < MAX_SHARED_LAYOUTS) kept = &shared->layouts[shared->count++];
+            else
+            {
+                kept = &shared->layouts[shared->next];
+                shared->next = (shared->next + 1) % MAX_SHARED_LAYOUTS;
+            }
+        }
+        kept->fontId = tex->layout.fontId;
+        kept->fontSize = tex->layout.fontSize;
+        kept->isScaleFree = tex->layout.isScaleFree;
+        kept->box = tex->layout.box;
+        kept->version = tex->layout.version;
+        kept->childVersions = tex->layout.childVersions;
+        if (childCount > 0) memcpy(kept->offsets, offsets, childCount*sizeof(Vector2));
+    }
+
+    const rSharedLayout *wanted = rFindSharedLayout(tex, fontId, fontSize);
+    if (wanted != NULL)
+    {
+        tex->layout.fontId = wanted->fontId;
+        tex->layout.fontSize = wanted->fontSize;
+        tex->layout.isScaleFree = wanted->isScaleFree;
+        tex->layout.box = wanted->box;
+        tex->layout.version = wanted->version;
+        tex->layout.childVersions = wanted->childVersions;
+        tex->layout.isValid = true;
+        if (childCount > 0) memcpy(offsets, wanted->offsets, childCount*sizeof(Vector2));
+    }
+}
+
+// Every layout an interned element computes gets a version none of its layouts had before, so that parents can tell
+// them apart when it switches between them. The versions belong to the element, so no other element is touched.
+static unsigned int rNextSharedLayoutVersion(RayTeX *tex)
+{
+    struct RayTeXSharedLayouts *shared = tex->layout.sharedLayouts;
+    unsigned int version = tex->layout.version;
+    if ((shared != NULL) && (shared->lastVersion > version)) version = shared->lastVersion;
+    version++;
+    if (shared != NULL) shared->lastVersion = version;
+    return version;
+}
+
+// Computes the element's box and child offsets from its children's current layouts, without visiting them.
+// Everything in layout scales linearly with the font size, so unless something below overrides it,
+// the layout is computed for a font size of 1 and scaled when it is read.
+// Returns true if the box changed, which is what parents read.
+static bool rComputeRayTeXLayout(rGlyphCache *cache, const Font *font, RayTeX *tex, float fontSize, unsigned int childVersions)
+{
+    int childCount = 0;
+    Vector2 *childOffsets = NULL;
+    RayTeXRef *children = rGetRayTeXChildren(tex, &childCount, &childOffsets);
+    bool isScaleFree = true;
+    for (int i = 0; (i < childCount) && isScaleFree; ++i)
+    {
+        isScaleFree = !children[i].ptr->isOverridingFontSize && children[i].ptr->layout.isScaleFree;
+    }
+    if (isScaleFree) fontSize = 1.0f;
+
+    RayTeXBox box = { 0 };
+    bool isOrdered = false;
+    switch (tex->mode)
+    {
+    case TEXMODE_SPACE:
+        box.width = MU_TO_PIXELS((float)tex->space.size, fontSize);
+        break;
+
+    case TEXMODE_VSPACE:
+        box.height = MU_TO_PIXELS((float)tex->space.size, fontSize);
+        break;
+
+    case TEXMODE_TEXT:
+        box = rTextElementBox(cache, font, tex, fontSize);
+        break;
+
+    case TEXMODE_SYMBOL:
+        box = rSymbolBox(cache, font, tex->symbol.content, fontSize);
+        break;
+
+    case TEXMODE_FRAC:
+        box = rFracBox(rGetLayoutBox(tex->frac.content[TEX_FRAC_NUMERATOR].ptr, fontSize),
+                       rGetLayoutBox(tex->frac.content[TEX_FRAC_DENOMINATOR].ptr, fontSize), fontSize, tex->frac.offsets);
+        break;
+
+    case TEXMODE_HORIZONTAL:
+    {
+        // Elements share a baseline, and only negative spaces step back
+        isOrdered = true;
+        for (int i = 0; i < tex->horizontal.elementCount; ++i)
+        {
+            RayTeXBox elementBox = rGetLayoutBox(tex->horizontal.content[i].ptr, fontSize);
+            if (elementBox.width < 0.0f) isOrdered = false;
+            box.width += elementBox.width;
+            if (elementBox.height > box.height) box.height = elementBox.height;
+            if (elementBox.depth > box.depth) box.depth = elementBox.depth;
+        }
+
+        float x = 0.0f;
+        for (int i = 0; i < tex->horizontal.elementCount; ++i)
+        {
+            RayTeXBox elementBox = rGetLayoutBox(tex->horizontal.content[i].ptr, fontSize);
+            tex->horizontal.offsets[i].x = x;
+            tex->horizontal.offsets[i].y = box.height - elementBox.height;
+            x += elementBox.width;
+        }
+    }
+        break;
+
+    case TEXMODE_VERTICAL:
+    {
+        // Rows are stacked and centered horizontally, with the whole stack centered on the math axis
+        float totalHeight = 0.0f;
+        isOrdered = true;
+        for (int i = 0; i < tex->vertical.elementCount; ++i)
+        {
+            RayTeXBox elementBox = rGetLayoutBox(tex->vertical.content[i].ptr, fontSize);
+            if (elementBox.height + elementBox.depth < 0.0f) isOrdered = false;
+            if (elementBox.width > box.width) box.width = elementBox.width;
+            totalHeight += elementBox.height + elementBox.depth;
+        }
+        box.height = totalHeight / 2.0f;
+        box.depth = totalHeight / 2.0f;
+
+        float y = 0.0f;
+        for (int i = 0; i < tex->vertical.elementCount; ++i)
+        {
+            RayTeXBox elementBox = rGetLayoutBox(tex->vertical.content[i].ptr, fontSize);
+            tex->vertical.offsets[i].x = (box.width - elementBox.width) / 2.0f;
+            tex->vertical.offsets[i].y = y;
+            y += elementBox.height + elementBox.depth;
+        }
+    }
+        break;
+
+    case TEXMODE_MATRIX:
+    {
+        // Columns are as wide as their widest cell and rows as tall as their tallest, found in one pass over the cells
+        int rowCount = tex->matrix.rowCount;
+        int columnCount = tex->matrix.columnCount;
+        float *columnWidths = tex->matrix.columnWidths;
+        float *rowHeights = tex->matrix.rowHeights;
+        float *rowDepths = tex->matrix.rowDepths;
+        isOrdered = true;
+        for (int column = 0; column < columnCount; ++column) columnWidths[column] = 0.0f;
+        for (int row = 0; row < rowCount; ++row)
+        {
+            rowHeights[row] = 0.0f;
+            rowDepths[row] = 0.0f;
+            for (int column = 0; column < columnCount; ++column)
+            {
+                RayTeXBox cellBox = rGetLayoutBox(tex->matrix.content[row*columnCount + column].ptr, fontSize);
+                if ((cellBox.height < 0.0f) || (cellBox.depth < 0.0f)) isOrdered = false;
+                if (cellBox.width > columnWidths[column]) columnWidths[column] = cellBox.width;
+                if (cellBox.height > rowHeights[row]) rowHeights[row] = cellBox.height;
+                if (cellBox.depth > rowDepths[row]) rowDepths[row] = cellBox.depth;
+            }
+        }
+        box = rMatrixBox(rowCount, columnCount, columnWidths, rowHeights, rowDepths, fontSize);
+
+        // Cells are centered in their column and share a baseline with their row
+        float columnSpacing = MU_TO_PIXELS((float)TEXMATRIX_COLUMN_SPACING, fontSize);
+        float rowSpacing = MU_TO_PIXELS((float)TEXMATRIX_ROW_SPACING, fontSize);
+        float y = 0.0f;
+        for (int row = 0; row < rowCount; ++row)
+        {
+            float x = 0.0f;
+            for (int column = 0; column < columnCount; ++column)
+            {
+                int index = row*columnCount + column;
+                RayTeXBox cellBox = rGetLayoutBox(tex->matrix.content[index].ptr, fontSize);
+                tex->matrix.offsets[index].x = x + (columnWidths[column] - cellBox.width) / 2.0f;
+                tex->matrix.offsets[index].y = y + rowHeights[row] - cellBox.height;
+                x += columnWidths[column] + columnSpacing;
+            }
+            y += rowHeights[row] + rowDepths[row] + rowSpacing;
+        }
+    }
+        break;
+
+    default: TRACELOG(LOG_WARNING, "RAYTEX: Unknown mode [%i]", tex->mode);
+    }
+
+    // Parents lay themselves out again when the version changes, which they can skip when the box came out the same
+    bool isChanged = (tex->layout.fontId != font->glyphs) || (tex->layout.fontSize != fontSize) || (tex->layout.isScaleFree != isScaleFree) ||
+                     (memcmp(&tex->layout.box, &box, sizeof(RayTeXBox)) != 0);
+    tex->layout.fontId = font->glyphs;
+    tex->layout.fontSize = fontSize;
+    tex->layout.box = box;
+    tex->layout.isValid = true;
+    tex->layout.isScaleFree = isScaleFree;
+    tex->layout.isOrdered = isOrdered;
+    if (tex->isInterned) tex->layout.version = rNextSharedLayoutVersion(tex);
+    else if (isChanged) tex->layout.version++;
+    tex->layout.childVersions = childVersions;
+    return isChanged || tex->isInterned;
+}
+
+// Lays out the element and its children, reusing every cached layout that is still valid.
+// Boxes are computed bottom-up here and child offsets are stored relative to their parent,
+// so drawing is a single top-down pass that only accumulates positions.
+// Edits mark the elements above them, so only marked elements visit their children. Elements with shared children
+// below them are always visited, since an edit to a shared child only knows one of its parents.
+// Returns true if the element's layout changed, so that the caller knows to recompute its own.
+// A shared child can also be recomputed for another parent, which the return value does not show, so children's
+// versions are compared as well.
+// Everything it reads comes through its arguments, so disjoint subtrees can be laid out on different threads with their own glyph caches.
+static bool rLayoutRayTeX(rGlyphCache *cache, const Font *font, RayTeX *tex, float fontSize)
+{
+    if (tex->isOverridingFontSize) fontSize = (float)tex->overrideFontSize;
+    if (tex->overrideFont != NULL) font = tex->overrideFont;
+    RAYTEX_STATS_ADD(layoutCount, 1);
+    if (tex->isInterned) rSwapSharedLayout(tex, font->glyphs, fontSize);
+
+    bool isCurrent = tex->layout.isValid && rIsLayoutFor(&tex->layout, font->glyphs, fontSize);
+    if (isCurrent && !tex->layout.isChildChanged && !tex->isSharing && (tex->layout.editCount == unlinkedEditCount))
+    {
+        RAYTEX_STATS_ADD(layoutCacheHits, 1);
+        return false;
+    }
+
+    // Shared elements could be reached from two workers at once, so subtrees with any stay on the calling thread.
+    // So do children of an element that was only marked, since an edit usually leaves all but a few of them current.
+    bool isSplittable = !tex->isSharing && (!isCurrent || (tex->layout.editCount != unlinkedEditCount));
+    tex->layout.isChildChanged = false;
+    tex->layout.editCount = unlinkedEditCount;
+
+    int childCount = 0;
+    Vector2 *offsets = NULL;
+    RayTeXRef *children = rGetRayTeXChildren(tex, &childCount, &offsets);
+    bool isChildChanged = rLayoutRayTeXChildren(cache, font, children, childCount, fontSize, isSplittable);
+
+    unsigned int childVersions = 0;
+    for (int i = 0; i < childCount; ++i)
+    {
+        // A later sibling can reach an interned child too, and leave it holding its layout for another font size
+        RayTeX *child = children[i].ptr;
+        if (child->isInterned)
+        {
+            const Font *childFont = (child->overrideFont != NULL) ? child->overrideFont : font;
+            float childFontSize = child->isOverridingFontSize ? (float)child->overrideFontSize : fontSize;
+            rSwapSharedLayout(child, childFont->glyphs, childFontSize);
+            if (!rIsLayoutFor(&child->layout, childFont->glyphs, childFontSize)) rLayoutRayTeX(cache, font, child, fontSize);
+        }
+        else if (children[i].isOwned) child->parent = (child->refCount == 1) ? tex : NULL;
+        childVersions += child->layout.version;
+    }
+    if (childVersions != tex->layout.childVersions) isChildChanged = true;
+
+    if (!isChildChanged && isCurrent)
+    {
+        RAYTEX_STATS_ADD(layoutCacheHits, 1);
+        return false;
+    }
+    RAYTEX_STATS_ADD(layoutCacheMisses, 1);
+    return rComputeRayTeXLayout(cache, font, tex, fontSize, childVersions);
+}
+
+// First child that only the element owns, which layout links back to it
+static RayTeX *rGetLinkedChild(const RayTeX *tex)
+{
+    int childCount = 0;
+    Vector2 *offsets = NULL;
+    RayTeXRef *children = rGetRayTeXChildren(tex, &childCount, &offsets);
+    for (int i = 0; i < childCount; ++i)
+    {
+        if (children[i].isOwned && (children[i].ptr->refCount == 1)) return children[i].ptr;
+    }
+    return NULL;
+}
+
+// Lays out a root where it is. Edits below an element mark what its children are linked to, so a root that keeps its
+// layout (isKept) links its children to itself and only lays out what was edited since the last call. A root passed
+// by value is a copy that is gone after the call, so its children are linked back to whatever they were linked to
+// before. Unless its children are linked to it, a root's child offsets may have been laid out since through another
+// element sharing them, for another font or font size, so the root's own layout is computed again.
+static bool rLayoutRayTeXRoot(rGlyphCache *cache, const Font *font, RayTeX *tex, float fontSize, bool isKept)
+{
+    int childCount = 0;
+    Vector2 *offsets = NULL;
+    RayTeXRef *children = rGetRayTeXChildren(tex, &childCount, &offsets);
+    RayTeX *child = rGetLinkedChild(tex);
+    RayTeX *owner = (child != NULL) ? child->parent : NULL;
+    if ((child != NULL) && (owner != tex)) tex->layout.isChildChanged = true;
+    if ((owner != tex) && (!isKept || (childCount > 0))) tex->layout.isValid = false;
+    bool isChanged = rLayoutRayTeX(cache, font, tex, fontSize);
+    if (isKept || (child == NULL) || (owner == tex) || (child->parent != tex)) return isChanged;
+
+    for (int i = 0; i < childCount; ++i)
+    {
+        if (children[i].isOwned && (children[i].ptr->parent == tex)) children[i].ptr->parent = owner;
+    }
+    return isChanged;
+}
+
+// Marks the way up from an edited element, so that layout visits what is above it.
+// An element that was laid out under a parent it does not know makes layout visit everything once.
+static void rMarkRayTeXChanged(RayTeX *tex)
+{
+    tex->layout.isValid = false;
+    if (tex->layout.sharedLayouts != NULL) tex->layout.sharedLayouts->count = 0;
+
+    // An element that was never laid out has nothing above it holding a layout computed from it
+    if (tex->layout.fontId == NULL) return;
+    if ((tex->parent == NULL) && !tex->isInterned) unlinkedEditCount++;
+    for (RayTeX *parent = tex->parent; (parent != NULL) && !parent->layout.isChildChanged; parent = parent->parent) parent->layout.isChildChanged = true;
+}
+
+// Marks what laying out a root where it is may have laid out for another font or font size behind the back of the
+// trees it is in. A copy shares its child offsets with what its children are linked to, which lays itself out again.
+// The parents of that, or of the root itself, visit it again. Only called on the calling thread.
+static void rMarkRayTeXOwnerChanged(const RayTeX *tex)
+{
+    RayTeX *child = rGetLinkedChild(tex);
+    if ((child != NULL) && (child->parent != NULL) && (child->parent != tex))
+    {
+        child->parent->layout.isValid = false;
+        tex = child->parent;
+    }
+    for (RayTeX *parent = tex->parent; (parent != NULL) && !parent->layout.isChildChanged; parent = parent->parent) parent->layout.isChildChanged = true;
+}
+
+// Lays out a root on the calling thread, and marks what it may have laid out behind the back of other trees
+static void rLayoutRayTeXTree(const Font *font, RayTeX *tex, float fontSize, bool isKept)
+{
+    rLayoutRayTeXRoot(&glyphCache, font, tex, fontSize, isKept);
+    rMarkRayTeXOwnerChanged(tex);
+}
+
+// A scale-free element keeps the same box when its font size changes, but its parent scales it differently
+static void rMarkRayTeXFontSizeChanged(RayTeX *tex)
+{
+    tex->layout.version++;
+    rMarkRayTeXChanged(tex);
+}
+
+RayTeXBox MeasureRayTeXBoxEx(Font font, RayTeX tex, int fontSize)
+{
+    RAYTEX_STATS_BEGIN("MeasureRayTeX");
+    rLayoutRayTeXTree(&font, &tex, (float)fontSize, false);
+    RAYTEX_STATS_END("MeasureRayTeX", measureTime);
+    return rGetLayoutBox(&tex, (float)fontSize);
+}
+
+Vector2 MeasureRayTeXEx(Font font, RayTeX tex, int fontSize)
+{
+    RayTeXBox box = MeasureRayTeXBoxEx(font, tex, fontSize);
+    Vector2 size = { 0 };
+    size.x = box.width;
+    size.y = box.height + box.depth;
+    return size;
+}
+int MeasureRayTeXWidth(RayTeX tex, int fontSize)
+{
+    return (int)MeasureRayTeXEx(GetFontDefault(), tex, fontSize).x;
+}
+int MeasureRayTeXHeight(RayTeX tex, int fontSize)
+{
+    return (int)MeasureRayTeXEx(GetFontDefault(), tex, fontSize).y;
+}
+
+void UpdateRayTeXColor(RayTeX *tex, Color color)
+{
+    // Color does not affect layout, so the cached layout stays valid
+    tex->overrideColor = color;
+    tex->isOverridingColor = true;
+}
+
+void UpdateRayTeXFontSize(RayTeX *tex, int fontSize)
+{
+    bool isChanged = !tex->isOverridingFontSize || (tex->overrideFontSize != fontSize);
+    tex->overrideFontSize = fontSize;
+    tex->isOverridingFontSize = true;
+    if (isChanged) rMarkRayTeXFontSizeChanged(tex);
+}
+
+void UpdateRayTeXFont(RayTeX *tex, Font font)
+{
+    if (tex->overrideFont == NULL) tex->overrideFont = RAYTEX_MALLOC(sizeof(Font));
+
+    if (tex->overrideFont != NULL)
+    {
+        *tex->overrideFont = font;
+        rMarkRayTeXChanged(tex);
+    }
+    else TRACELOG(LOG_ERROR, "RAYTEX: UpdateRayTeXFont() failed to allocate");
+}
+
+void ClearRayTeXColor(RayTeX *tex)
+{
+    tex->isOverridingColor = false;
+}
+
+void ClearRayTeXFontSize(RayTeX *tex)
+{
+    bool isChanged = tex->isOverridingFontSize;
+    tex->isOverridingFontSize = false;
+    if (isChanged) rMarkRayTeXFontSizeChanged(tex);
+}
+
+void ClearRayTeXFont(RayTeX *tex)
+{
+    bool isChanged = (tex->overrideFont != NULL);
+    RAYTEX_FREE(tex->overrideFont);
+    tex->overrideFont = NULL;
+    if (isChanged) rMarkRayTeXChanged(tex);
+}
+
+void InvalidateRayTeXLayout(RayTeX *tex)
+{
+    // The content may have been replaced, so decode it again
+    if (tex->mode == TEXMODE_TEXT) rDecodeRayTeXText(tex);
+    rMarkRayTeXChanged(tex);
+}
+
+static void rUpdateRayTeXTextV(RayTeX *tex, const char *fmt, va_list args)
+{
+    if (tex->mode != TEXMODE_TEXT)
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: UpdateRayTeXText() only valid for TEXMODE_TEXT");
+        return;
+    }
+    if (!rFormatRayTeXText(tex, fmt, args)) return;
+
+    // Only this element's width changes, so layout only visits the elements above it
+    rDecodeRayTeXText(tex);
+    rMarkRayTeXChanged(tex);
+}
+
+void UpdateRayTeXTextf(RayTeX *tex, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    rUpdateRayTeXTextV(tex, fmt, args);
+    va_end(args);
+}
+
+void UpdateRayTeXText(RayTeX *tex, const char *text)
+{
+    UpdateRayTeXTextf(tex, "%s", text);
+}
+
+const char *GetRayTeXText(const RayTeX *tex, int *length)
+{
+    if (tex->mode != TEXMODE_TEXT) return NULL;
+    if (length != NULL) *length = rTextLength(tex);
+    return rTextContent(tex);
+}
+
+RayTeX RayTeXColor(RayTeX tex, Color color)
+{
+    UpdateRayTeXColor(&tex, color);
+    return tex;
+}
+
+RayTeX RayTeXFontSize(RayTeX tex, int fontSize)
+{
+    UpdateRayTeXFontSize(&tex, fontSize);
+    return tex;
+}
+
+RayTeX RayTeXFont(RayTeX tex, Font font)
+{
+    UpdateRayTeXFont(&tex, font);
+    return tex;
+}
+
+static void rSetRayTeXMatrixContent(RayTeX *element, RayTeXRef *content);
+
+// Copies the element itself. The copy takes a reference to the original's child array and text instead of copying
+// them, which either of them copies before changing it.
+static bool rCopyRayTeX(const RayTeX *tex, RayTeX *copy)
+{
+    *copy = *tex;
+    copy->refCount = 0;
+    copy->parent = NULL;
+    copy->isInterned = false;
+    copy->layout.sharedLayouts = NULL;
+    copy->overrideFont = NULL;
+    if (tex->overrideFont != NULL)
+    {
+        copy->overrideFont = RAYTEX_MALLOC(sizeof(Font));
+        if (copy->overrideFont == NULL)
+        {
+            TRACELOG(LOG_ERROR, "RAYTEX: Failed to allocate a copy of an element");
+            return false;
+        }
+        *copy->overrideFont = *tex->overrideFont;
+    }
+
+    int childCount = 0;
+    Vector2 *offsets = NULL;
+    RayTeXRef *children = rGetRayTeXChildren(tex, &childCount, &offsets);
+    switch (tex->mode)
+    {
+    case TEXMODE_TEXT:
+        // Decoded buffers are shaped for one font at a time, so only the content is shared
+        if (tex->text.isOwned) rGetSharedHeader(tex->text.content)->refCount++;
+        copy->text.codepoints = NULL;
+        copy->text.codepointCount = 0;
+        copy->text.codepointCapacity = 0;
+        rDecodeRayTeXText(copy);
+        copy->layout.isValid = false; // Shaped again on the next layout
+        break;
+
+    case TEXMODE_FRAC:
+        // The children are held in the element itself
+        for (int i = 0; i < childCount; ++i)
+        {
+            if (children[i].isOwned) children[i].ptr->refCount++;
+        }
+        break;
+
+    case TEXMODE_HORIZONTAL:
+    case TEXMODE_VERTICAL:
+    case TEXMODE_MATRIX:
+        if (children != NULL) rGetSharedHeader(children)->refCount++;
+        break;
+
+    default: break;
+    }
+
+    if (childCount > 0) copy->isSharing = true;
+    return true;
+}
+
+// Gives the element a child array of its own, taking a reference to each child. Layout writes child offsets to the
+// array without knowing who else holds it, and on threads where nothing can be allocated, so elements get their own
+// before they go into a tree. Returns false if the array is still shared.
+static bool rUnshareRayTeXChildren(RayTeX *tex)
+{
+    if ((tex->mode != TEXMODE_HORIZONTAL) && (tex->mode != TEXMODE_VERTICAL) && (tex->mode != TEXMODE_MATRIX)) return true;
+    int childCount = 0;
+    Vector2 *offsets = NULL;
+    RayTeXRef *children = rGetRayTeXChildren(tex, &childCount, &offsets);
+    if (!rIsShared(children)) return true;
+
+    size_t size = childCount*(sizeof(RayTeXRef) + sizeof(Vector2));
+    if (tex->mode == TEXMODE_MATRIX) size += (tex->matrix.columnCount + 2*tex->matrix.rowCount)*sizeof(float);
+    RayTeXRef *content = rAllocShared(size);
+    if (content == NULL)
+    {
+        TRACELOG(LOG_ERROR, "RAYTEX: Failed to copy a shared child array, edits will show in every element sharing it");
+        return false;
+    }
+    memcpy(content, children, size);
+    for (int i = 0; i < childCount; ++i)
+    {
+        if (content[i].isOwned) content[i].ptr->refCount++;
+    }
+    rReleaseShared(children);
+
+    // Vertical has the same layout as horizontal
+    if (tex->mode == TEXMODE_MATRIX) rSetRayTeXMatrixContent(tex, content);
+    else
+    {
+        tex->horizontal.content = content;
+        tex->horizontal.offsets = (Vector2 *)(content + childCount);
+    }
+    if (childCount > 0) tex->isSharing = true;
+    return true;
+}
+
+// Hands out a child for editing. One shared with a clone or an interner is replaced by a copy first, so that the edit
+// only shows up in this tree. Children added by pointer are handed out as they are, since sharing them was asked for.
+// A child array shared with a clone is copied before that, since the copy takes the child's place in it.
+static RayTeX *rGetEditableRayTeXChild(RayTeX *parent, int index)
+{
+    rUnshareRayTeXChildren(parent);
+    int childCount = 0;
+    Vector2 *offsets = NULL;
+    RayTeXRef *children = rGetRayTeXChildren(parent, &childCount, &offsets);
+    if (children == NULL) return NULL;
+    RayTeXRef *ref = &children[index];
+    bool isShared = ref->isOwned ? (ref->ptr->refCount > 1) : ref->ptr->isInterned;
+    if (!isShared) return ref->ptr;
+
+    RayTeX *node = RAYTEX_MALLOC(sizeof(RayTeX));
+    if ((node == NULL) || !rCopyRayTeX(ref->ptr, node))
+    {
+        RAYTEX_FREE(node);
+        TRACELOG(LOG_ERROR, "RAYTEX: Failed to copy a shared element for editing, edits will show in every tree sharing it");
+        return ref->ptr;
+    }
+    if (!rUnshareRayTeXChildren(node))
+    {
+        UnloadRayTeX(*node);
+        RAYTEX_FREE(node);
+        return ref->ptr;
+    }
+    RAYTEX_STATS_ADD(liveNodeCount, 1);
+
+    // The original keeps at least one other reference, so releasing this one never unloads it
+    if (ref->isOwned) ref->ptr->refCount--;
+    node->refCount = 1;
+    ref->isOwned = true;
+    ref->ptr = node;
+    if (node->isSharing) parent->isSharing = true;
+    rMarkRayTeXChanged(parent); // Visits the parent, which links the copy to it
+    return node;
+}
+
+RayTeX CloneRayTeX(RayTeX tex)
+{
+    RayTeX clone = { 0 };
+    if (rCopyRayTeX(&tex, &clone)) TRACELOG(LOG_DEBUG, "RAYTEX: TeX element cloned successfully");
+    return clone;
+}
+
+RayTeX *RayTeXFracNumerator(RayTeX *fracTex)
+{
+    if (fracTex->mode != TEXMODE_FRAC) TRACELOG(LOG_WARNING, "RAYTEX: RayTeXFracNumerator() only valid for TEXMODE_FRAC");
+    return rGetEditableRayTeXChild(fracTex, TEX_FRAC_NUMERATOR);
+}
+
+RayTeX *RayTeXFracDenominator(RayTeX *fracTex)
+{
+    if (fracTex->mode != TEXMODE_FRAC) TRACELOG(LOG_WARNING, "RAYTEX: RayTeXFracDenominator() only valid for TEXMODE_FRAC");
+    return rGetEditableRayTeXChild(fracTex, TEX_FRAC_DENOMINATOR);
+}
+
+RayTeX *RayTeXHorizontalChild(RayTeX *horizontalTex, int index)
+{
+    if (horizontalTex->mode != TEXMODE_HORIZONTAL) TRACELOG(LOG_WARNING, "RAYTEX: RayTeXHorizontalChild() only valid for TEXMODE_HORIZONTAL");
+    if (index < 0)
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXHorizontalChild() index (%i) cannot be negative", index);
+        //index = 0;
+    }
+    int lastChildIndex = horizontalTex->horizontal.elementCount - 1;
+    if (index > lastChildIndex)
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXHorizontalChild() index (%i) cannot be higher than the index of horizontalTex's last child (%i)",
+                 index, lastChildIndex);
+        //index = lastChildIndex;
+    }
+    return rGetEditableRayTeXChild(horizontalTex, index);
+}
+
+RayTeX *RayTeXVerticalChild(RayTeX *verticalTex, int index)
+{
+    if (verticalTex->mode != TEXMODE_VERTICAL) TRACELOG(LOG_WARNING, "RAYTEX: RayTeXVerticalChild() only valid for TEXMODE_VERTICAL");
+    if (index < 0)
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXVerticalChild() index (%i) cannot be negative", index);
+        //index = 0;
+    }
+    int lastChildIndex = verticalTex->horizontal.elementCount - 1;
+    if (index > lastChildIndex)
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXVerticalChild() index (%i) cannot be higher than the index of verticalTex's last child (%i)",
+                 index, lastChildIndex);
+        //index = lastChildIndex;
+    }
+    return rGetEditableRayTeXChild(verticalTex, index);
+}
+
+RayTeX *RayTeXMatrixCell(RayTeX *matrixTex, int rowIndex, int columnIndex)
+{
+    if (matrixTex->mode != TEXMODE_MATRIX) TRACELOG(LOG_WARNING, "RAYTEX: RayTeXMatrixCell() only valid for TEXMODE_MATRIX");
+
+    if (rowIndex < 0)
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXMatrixCell() rowIndex (%i) cannot be negative", rowIndex);
+        //rowIndex = 0;
+    }
+    int lastRowIndex = matrixTex->matrix.rowCount - 1;
+    if (rowIndex > lastRowIndex)
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXMatrixCell() rowIndex (%i) cannot be higher than the index of matrixTex's last row (%i)",
+                 rowIndex, lastRowIndex);
+        //rowIndex = lastRowIndex;
+    }
+
+    if (columnIndex < 0)
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXMatrixCell() columnIndex (%i) cannot be negative", columnIndex);
+        //columnIndex = 0;
+    }
+    int lastColumnIndex = matrixTex->matrix.columnCount - 1;
+    if (columnIndex > lastColumnIndex)
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: RayTeXMatrixCell() columnIndex (%i) cannot be higher than the index of matrixTex's last column (%i)",
+                 columnIndex, lastColumnIndex);
+        //columnIndex = lastColumnIndex;
+    }
+
+    return rGetEditableRayTeXChild(matrixTex, rowIndex * matrixTex->matrix.columnCount + columnIndex);
+}
+
+RayTeX GenRayTeXSpace(int mu)
+{
+    RayTeX element = { 0 };
+    element.mode = TEXMODE_SPACE;
+    element.space.size = mu;
+    TRACELOG(LOG_DEBUG, "RAYTEX: TeX %i mu horizontal space element generated successfully", mu);
+    return element;
+}
+
+RayTeX GenRayTeXVSpace(int mu)
+{
+    RayTeX element = { 0 };
+    element.mode = TEXMODE_VSPACE;
+    element.space.size = mu;
+    TRACELOG(LOG_DEBUG, "RAYTEX: TeX %i mu vertical space element generated successfully", mu);
+    return element;
 }
 
 RayTeX GenRayTeXText(const char *content)
 {
-    RayTeX element = { 0 };
-    element.mode = TEXMODE_TEXT;
-    element.text.content = content;
-    TRACELOG(LOG_INFO, "RAYTEX: TeX text element \"%s\" generated successfully", content);
-    return element;
+    RayTeX element = { 0 };
+    element.mode = TEXMODE_TEXT;
+    element.text.content = content;
+    rDecodeRayTeXText(&element);
+    TRACELOG(LOG_DEBUG, "RAYTEX: TeX text element \"%s\" generated successfully", content);
+    return element;
+}
+
+RayTeX GenRayTeXTextf(const char *fmt, ...)
+{
+    RayTeX element = { 0 };
+    element.mode = TEXMODE_TEXT;
+    va_list args;
+    va_start(args, fmt);
+    bool isFormatted = rFormatRayTeXText(&element, fmt, args);
+    va_end(args);
+    if (isFormatted)
+    {
+        rDecodeRayTeXText(&element);
+        TRACELOG(LOG_DEBUG, "RAYTEX: TeX text element \"%s\" generated successfully", rTextContent(&element));
+    }
+    else
+    {
+        // Stays a valid, empty element
+        element.text.isInline = true;
+        element.text.inlineContent[0] = '\0';
+        TRACELOG(LOG_ERROR, "RAYTEX: GenRayTeXTextf() failed to format \"%s\"", fmt);
+    }
+    return element;
+}
+
+RayTeX GenRayTeXSymbol(RayTeXSymbol symbol)
+{
+    RayTeX element = { 0 };
+    element.mode = TEXMODE_SYMBOL;
+    element.symbol.content = symbol;
+    TRACELOG(LOG_DEBUG, "RAYTEX: TeX symbol element generated successfully");
+    return element;
+}
+
+static RayTeXInterner *currentInterner = NULL;
+
+// Stands in for children that could not be allocated. It is shared by every tree like an interned element, so it is
+// never unloaded and the accessors copy it before it is edited.
+static RayTeX failedTex = { .mode = TEXMODE_SPACE, .isInterned = true };
+
+RayTeXInterner LoadRayTeXInterner(void)
+{
+    RayTeXInterner interner = { 0 };
+    return interner;
+}
+
+void UnloadRayTeXInterner(RayTeXInterner *interner)
+{
+    if (currentInterner == interner) currentInterner = NULL;
+    for (int i = 0; i < interner->capacity; ++i)
+    {
+        if (interner->nodes[i] == NULL) continue;
+        UnloadRayTeX(*interner->nodes[i]);
+        RAYTEX_FREE(interner->nodes[i]);
+        RAYTEX_STATS_ADD(liveNodeCount, -1);
+    }
+    TRACELOG(LOG_DEBUG, "RAYTEX: Interner with %i elements unloaded successfully", interner->count);
+    RL_FREE(interner->nodes);
+    interner->nodes = NULL;
+    interner->capacity = 0;
+    interner->count = 0;
+}
+
+void SetRayTeXInterner(RayTeXInterner *interner)
+{
+    currentInterner = interner;
+}
+
+static unsigned int rHashBytes(unsigned int hash, const void *data, size_t size)
+{
+    // FNV-1a
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; ++i) hash = (hash ^ bytes[i])*16777619u;
+    return hash;
+}
+
+// Children are hashed and compared by identity, since they were interned before their parent
+static unsigned int rHashRayTeX(const RayTeX *tex)
+{
+    int mode = tex->mode;
+    unsigned int hash = rHashBytes(2166136261u, &mode, sizeof(int));
+    if (tex->isOverridingColor) hash = rHashBytes(hash, &tex->overrideColor, sizeof(Color));
+    if (tex->isOverridingFontSize) hash = rHashBytes(hash, &tex->overrideFontSize, sizeof(int));
+    if (tex->overrideFont != NULL) hash = rHashBytes(hash, &tex->overrideFont->glyphs, sizeof(GlyphInfo *));
+
+    switch (tex->mode)
+    {
+    case TEXMODE_SPACE:
+    case TEXMODE_VSPACE: return rHashBytes(hash, &tex->space.size, sizeof(int));
+    case TEXMODE_SYMBOL: return rHashBytes(hash, &tex->symbol.content, sizeof(RayTeXSymbol));
+    case TEXMODE_TEXT: return rHashBytes(hash, rTextContent(tex), rTextLength(tex));
+    case TEXMODE_MATRIX: hash = rHashBytes(hash, &tex->matrix.columnCount, sizeof(int)); break;
+    default: break;
+    }
+
+    int childCount = 0;
+    Vector2 *offsets = NULL;
+    RayTeXRef *children = rGetRayTeXChildren(tex, &childCount, &offsets);
+    for (int i = 0; i < childCount; ++i) hash = rHashBytes(hash, &children[i].ptr, sizeof(RayTeX *));
+    return hash;
+}
+
+static bool rIsRayTeXEqual(const RayTeX *a, const RayTeX *b)
+{
+    if ((a->mode != b->mode) || (a->fillsParentCrossAxis != b->fillsParentCrossAxis)) return false;
+    if ((a->isOverridingColor != b->isOverridingColor) || (a->isOverridingColor && (memcmp(&a->overrideColor, &b->overrideColor, sizeof(Color)) != 0))) return false;
+    if ((a->isOverridingFontSize != b->isOverridingFontSize) || (a->isOverridingFontSize && (a->overrideFontSize != b->overrideFontSize))) return false;
+    if ((a->overrideFont == NULL) != (b->overrideFont == NULL)) return false;
+    if ((a->overrideFont != NULL) && (a->overrideFont->glyphs != b->overrideFont->glyphs)) return false;
+
+    switch (a->mode)
+    {
+    case TEXMODE_SPACE:
+    case TEXMODE_VSPACE: return a->space.size == b->space.size;
+    case TEXMODE_SYMBOL: return a->symbol.content == b->symbol.content;
+    case TEXMODE_TEXT:
+    {
+        int length = rTextLength(a);
+        return (length == rTextLength(b)) && (memcmp(rTextContent(a), rTextContent(b), length) == 0);
+    }
+    case TEXMODE_MATRIX: if (a->matrix.columnCount != b->matrix.columnCount) return false; break;
+    default: break;
+    }
+
+    int aCount = 0;
+    int bCount = 0;
+    Vector2 *offsets = NULL;
+    RayTeXRef *aChildren = rGetRayTeXChildren(a, &aCount, &offsets);
+    RayTeXRef *bChildren = rGetRayTeXChildren(b, &bCount, &offsets);
+    if (aCount != bCount) return false;
+    for (int i = 0; i < aCount; ++i)
+    {
+        if (aChildren[i].ptr != bChildren[i].ptr) return false;
+    }
+    return true;
+}
+
+static bool rGrowRayTeXInterner(RayTeXInterner *interner)
+{
+    int capacity = (interner->capacity > 0) ? interner->capacity*2 : 64;
+    RayTeX **nodes = RL_CALLOC(capacity, sizeof(RayTeX *));
+    if (nodes == NULL) return false;
+
+    for (int i = 0; i < interner->capacity; ++i)
+    {
+        if (interner->nodes[i] == NULL) continue;
+        unsigned int slot = rHashRayTeX(interner->nodes[i]) & (capacity - 1);
+        while (nodes[slot] != NULL) slot = (slot + 1) & (capacity - 1);
+        nodes[slot] = interner->nodes[i];
+    }
+    RL_FREE(interner->nodes);
+    interner->nodes = nodes;
+    interner->capacity = capacity;
+    return true;
+}
+
+// Stores the element in the interner, or unloads it if an equal one is there already. Either way the element
+// returned is shared, and belongs to the interner. Returns false if the interner could not grow.
+static bool rInternRayTeX(RayTeXInterner *interner, const RayTeX *value, RayTeX **interned)
+{
+    if (((interner->count + 1)*2 > interner->capacity) && !rGrowRayTeXInterner(interner)) return false;
+
+    unsigned int slot = rHashRayTeX(value) & (interner->capacity - 1);
+    for (; interner->nodes[slot] != NULL; slot = (slot + 1) & (interner->capacity - 1))
+    {
+        if (rIsRayTeXEqual(interner->nodes[slot], value))
+        {
+            UnloadRayTeX(*value);
+            RAYTEX_STATS_ADD(internHits, 1);
+            *interned = interner->nodes[slot];
+            return true;
+        }
+    }
+
+    RayTeX *node = RAYTEX_MALLOC(sizeof(RayTeX));
+    if (node == NULL) return false;
+    RAYTEX_STATS_ADD(liveNodeCount, 1);
+    *node = *value;
+    node->isInterned = true;
+    interner->nodes[slot] = node;
+    interner->count++;
+    *interned = node;
+    return true;
+}
+
+// Links the children only the element owns to it, once it is where it stays. A root laid out where it was before
+// has its children linked to that place, which edits below would otherwise still mark.
+static void rLinkRayTeXChildren(RayTeX *tex)
+{
+    int childCount = 0;
+    Vector2 *offsets = NULL;
+    RayTeXRef *children = rGetRayTeXChildren(tex, &childCount, &offsets);
+    for (int i = 0; i < childCount; ++i)
+    {
+        if (children[i].isOwned && (children[i].ptr->refCount == 1)) children[i].ptr->parent = tex;
+    }
+}
+
+static RayTeXRef RayTeXRefFromValue(RayTeX value)
+{
+    rUnshareRayTeXChildren(&value);
+    value.parent = NULL;
+    RayTeX *interned = NULL;
+    if ((currentInterner != NULL) && rInternRayTeX(currentInterner, &value, &interned))
+    {
+        rLinkRayTeXChildren(interned);
+        RayTeXRef ref = { 0 };
+        ref.isOwned = false;
+        ref.ptr = interned;
+        return ref;
+    }
+
+    RayTeX *pointer = RAYTEX_MALLOC(sizeof(RayTeX));
+    if (pointer != NULL)
+    {
+        RAYTEX_STATS_ADD(liveNodeCount, 1);
+        *pointer = value;
+        pointer->refCount = 1;
+        rLinkRayTeXChildren(pointer);
+        RayTeXRef ref = { 0 };
+        ref.isOwned = true;
+        ref.ptr = pointer;
+        return ref;
+    }
+
+    // Nothing holds the element any more, so it is unloaded and an empty space takes its place
+    TRACELOG(LOG_ERROR, "RAYTEX: RayTeXRefFromValue() failed to allocate, the element is replaced by an empty space");
+    UnloadRayTeX(value);
+    RayTeXRef ref = { 0 };
+    ref.isOwned = false;
+    ref.ptr = &failedTex;
+    return ref;
+}
+
+static RayTeXRef RayTeXRefFromPointer(RayTeX *pointer)
+{
+    if (pointer != NULL) rUnshareRayTeXChildren(pointer);
+    RayTeXRef ref = { 0 };
+    ref.isOwned = false;
+    ref.ptr = pointer;
+    return ref;
+}
+
+// Containers remember whether an element they do not own is below them, since shared elements must not be laid out
+// on several threads at once
+static void rUpdateRayTeXSharing(RayTeX *tex)
+{
+    int childCount = 0;
+    Vector2 *offsets = NULL;
+    RayTeXRef *children = rGetRayTeXChildren(tex, &childCount, &offsets);
+    tex->isSharing = false;
+    for (int i = 0; i < childCount; ++i)
+    {
+        if ((children[i].ptr != NULL) && (!children[i].isOwned || (children[i].ptr->refCount > 1) || children[i].ptr->isSharing)) tex->isSharing = true;
+    }
+}
+
+RayTeX GenRayTeXFrac(char fmt0, char fmt1, ...)
+{
+    RayTeX element = { 0 };
+    element.mode = TEXMODE_FRAC;
+    va_list args;
+    va_start(args, fmt1);
+    for (int i = 0; i < 2; ++i)
+    {
+        char ch = i == 0 ? fmt0 : fmt1;
+        switch (ch)
+        {
+            case ' ': element.frac.content[i] = RayTeXRefFromValue(GenRayTeXSpace(va_arg(args, int)));           break;
+            case 't': element.frac.content[i] = RayTeXRefFromValue(GenRayTeXText(va_arg(args, const char*)));    break;
+            case 's': element.frac.content[i] = RayTeXRefFromValue(GenRayTeXSymbol(va_arg(args, RayTeXSymbol))); break;
+            case 'i': element.frac.content[i] = RayTeXRefFromValue(GenRayTeXTextf("%i", va_arg(args, int)));     break;
+            case 'v': element.frac.content[i] = RayTeXRefFromValue(va_arg(args, RayTeX));                        break;
+            case 'p': element.frac.content[i] = RayTeXRefFromPointer(va_arg(args, RayTeX*));                     break;
+
+            default: TRACELOG(LOG_WARNING, "RAYTEX: GenRayTeXFrac() at index %i of fmt '%c','%c': meaning of '%c' is unknown", i, fmt0, fmt1, ch);
+        }
+    }
+    va_end(args);
+    rUpdateRayTeXSharing(&element);
+    TRACELOG(LOG_DEBUG, "RAYTEX: TeX fraction element generated successfully");
+    return element;
+}
+
+// Unloads the elements passed by value to a container that could not be allocated, since nothing else holds them
+static void rUnloadRayTeXArgs(const char *fmt, va_list args)
+{
+    for (const char *c = fmt; *c; ++c)
+    {
+        switch (*c)
+        {
+        case ' ': case 'i': (void)va_arg(args, int);        break;
+        case 't': (void)va_arg(args, const char*);          break;
+        case 's': (void)va_arg(args, RayTeXSymbol);         break;
+        case 'v': UnloadRayTeX(va_arg(args, RayTeX));       break;
+        case 'p': (void)va_arg(args, RayTeX*);              break;
+        default: break;
+        }
+    }
+}
+
+RayTeX GenRayTeXHorizontal(const char *fmt, ...)
+{
+    int count = (int)strlen(fmt);
+    RayTeX element = { 0 };
+    element.mode = TEXMODE_HORIZONTAL;
+    element.horizontal.content = rAllocShared(count * (sizeof(RayTeXRef) + sizeof(Vector2)));
+    if (element.horizontal.content != NULL)
+    {
+        element.horizontal.elementCount = count;
+        element.horizontal.offsets = (Vector2 *)(element.horizontal.content + count);
+        va_list args;
+        va_start(args, fmt);
+        for (int i = 0; i < count; ++i)
+        {
+            switch (fmt[i])
+            {
+            case ' ': element.horizontal.content[i] = RayTeXRefFromValue(GenRayTeXSpace(va_arg(args, int)));           break;
+            case 't': element.horizontal.content[i] = RayTeXRefFromValue(GenRayTeXText(va_arg(args, const char*)));    break;
+            case 's': element.horizontal.content[i] = RayTeXRefFromValue(GenRayTeXSymbol(va_arg(args, RayTeXSymbol))); break;
+            case 'i': element.horizontal.content[i] = RayTeXRefFromValue(GenRayTeXTextf("%i", va_arg(args, int)));     break;
+            case 'v': element.horizontal.content[i] = RayTeXRefFromValue(va_arg(args, RayTeX));                        break;
+            case 'p': element.horizontal.content[i] = RayTeXRefFromPointer(va_arg(args, RayTeX*));                     break;
+
+            default: TRACELOG(LOG_WARNING, "RAYTEX: GenRayTeXHorizontal() at index %i of fmt \"%s\": meaning of '%c' is unknown", i, fmt, fmt[i]);
+            }
+        }
+        va_end(args);
+        rUpdateRayTeXSharing(&element);
+        TRACELOG(LOG_DEBUG, "RAYTEX: TeX horizontal with %i elements generated successfully", count);
+    }
+    else
+    {
+        TRACELOG(LOG_ERROR, "RAYTEX: GenRayTeXHorizontal() failed to allocate");
+        va_list args;
+        va_start(args, fmt);
+        rUnloadRayTeXArgs(fmt, args);
+        va_end(args);
+    }
+    return element;
+}
+
+// WARNING: Elements added by value are moved into the vertical, not copied.
+// Unloading them outside of the vertical will also unload them for the vertical,
+// and unloading the vertical will also unload them outside of the vertical. Pass a CloneRayTeX() to keep using one.
+RayTeX GenRayTeXVertical(const char *fmt, ...)
+{
+    int count = (int)strlen(fmt);
+    RayTeX element = { 0 };
+    element.mode = TEXMODE_VERTICAL;
+    element.vertical.content = rAllocShared(count * (sizeof(RayTeXRef) + sizeof(Vector2)));
+    if (element.vertical.content != NULL)
+    {
+        element.vertical.elementCount = count;
+        element.vertical.offsets = (Vector2 *)(element.vertical.content + count);
+        va_list args;
+        va_start(args, fmt);
+        for (int i = 0; i < count; ++i)
+        {
+            switch (fmt[i])
+            {
+            case ' ': element.vertical.content[i] = RayTeXRefFromValue(GenRayTeXSpace(va_arg(args, int)));           break;
+            case 't': element.vertical.content[i] = RayTeXRefFromValue(GenRayTeXText(va_arg(args, const char*)));    break;
+            case 's': element.vertical.content[i] = RayTeXRefFromValue(GenRayTeXSymbol(va_arg(args, RayTeXSymbol))); break;
+            case 'i': element.vertical.content[i] = RayTeXRefFromValue(GenRayTeXTextf("%i", va_arg(args, int)));     break;
+            case 'v': element.vertical.content[i] = RayTeXRefFromValue(va_arg(args, RayTeX));                        break;
+            case 'p': element.vertical.content[i] = RayTeXRefFromPointer(va_arg(args, RayTeX*));                     break;
+
+            default: TRACELOG(LOG_WARNING, "RAYTEX: GenRayTeXVertical() at index %i of fmt \"%s\": meaning of '%c' is unknown", i, fmt, fmt[i]);
+            }
+        }
+        va_end(args);
+        rUpdateRayTeXSharing(&element);
+        TRACELOG(LOG_DEBUG, "RAYTEX: TeX vertical with %i elements generated successfully", count);
+    }
+    else
+    {
+        TRACELOG(LOG_ERROR, "RAYTEX: GenRayTeXVertical() failed to allocate");
+        va_list args;
+        va_start(args, fmt);
+        rUnloadRayTeXArgs(fmt, args);
+        va_end(args);
+    }
+    return element;
+}
+
+// Allocates a matrix's cells together with the cell offsets and the column and row extents that layout fills in
+static bool rAllocRayTeXMatrix(RayTeX *element, int rowCount, int columnCount)
+{
+    int elementCount = rowCount*columnCount;
+    element->matrix.content = rAllocShared(elementCount*(sizeof(RayTeXRef) + sizeof(Vector2)) + (columnCount + 2*rowCount)*sizeof(float));
+    if (element->matrix.content == NULL) return false;
+
+    element->matrix.rowCount = rowCount;
+    element->matrix.columnCount = columnCount;
+    rSetRayTeXMatrixContent(element, element->matrix.content);
+    return true;
+}
+
+// Points a matrix at its cells, and at the offsets and extents stored after them
+static void rSetRayTeXMatrixContent(RayTeX *element, RayTeXRef *content)
+{
+    int elementCount = element->matrix.rowCount*element->matrix.columnCount;
+    element->matrix.content = content;
+    element->matrix.offsets = (Vector2 *)(content + elementCount);
+    element->matrix.columnWidths = (float *)(element->matrix.offsets + elementCount);
+    element->matrix.rowHeights = element->matrix.columnWidths + element->matrix.columnCount;
+    element->matrix.rowDepths = element->matrix.rowHeights + element->matrix.rowCount;
+}
+
+// WARNING: Elements added by value are moved into the matrix, not copied.
+// Unloading them outside of the matrix will also unload them for the matrix,
+// and unloading the matrix will also unload them outside of the matrix. Pass a CloneRayTeX() to keep using one.
+RayTeX GenRayTeXMatrix(const char *fmt, ...)
+{
+    // Every character but '\\' is a cell, and rows end at '\\' (a trailing one does not start an empty row)
+    int rowCount = 0;
+    int columnCount = 0;
+    {
+        int currentRowColumnCount = 0;
+        for (const char *c = fmt; *c; ++c)
+        {
+            if (*c == '\\')
+            {
+                ++rowCount;
+                currentRowColumnCount = 0;
+            }
+            else if (++currentRowColumnCount > columnCount) columnCount = currentRowColumnCount;
+        }
+        if (currentRowColumnCount > 0) ++rowCount;
+    }
+
+    RayTeX element = { 0 };
+    element.mode = TEXMODE_MATRIX;
+    int elementCount = rowCount*columnCount;
+    if (rAllocRayTeXMatrix(&element, rowCount, columnCount))
+    {
+        va_list args;
+        va_start(args, fmt);
+        int row = 0;
+        int column = 0;
+        for (const char *c = fmt; *c; ++c)
+        {
+            RayTeXRef *cell = &element.matrix.content[row*columnCount + column];
+            switch (*c)
+            {
+            case ' ': *cell = RayTeXRefFromValue(GenRayTeXSpace(va_arg(args, int)));           break;
+            case 't': *cell = RayTeXRefFromValue(GenRayTeXText(va_arg(args, const char*)));    break;
+            case 's': *cell = RayTeXRefFromValue(GenRayTeXSymbol(va_arg(args, RayTeXSymbol))); break;
+            case 'i': *cell = RayTeXRefFromValue(GenRayTeXTextf("%i", va_arg(args, int)));     break;
+            case 'v': *cell = RayTeXRefFromValue(va_arg(args, RayTeX));                        break;
+            case 'p': *cell = RayTeXRefFromPointer(va_arg(args, RayTeX*));                     break;
+            case '&': *cell = RayTeXRefFromValue(BLANK_TEX);                                   break;
+            case '\\':
+                // Pad the rest of the row with blank cells
+                for (; column < columnCount; ++column) element.matrix.content[row*columnCount + column] = RayTeXRefFromValue(BLANK_TEX);
+                column = 0;
+                ++row;
+                continue;
+
+            default:
+                TRACELOG(LOG_WARNING, "RAYTEX: GenRayTeXMatrix() at index %i of fmt \"%s\": meaning of '%c' is unknown", (int)(c - fmt), fmt, *c);
+                *cell = RayTeXRefFromValue(BLANK_TEX);
+            }
+            ++column;
+        }
+        if (column > 0)
+        {
+            for (; column < columnCount; ++column) element.matrix.content[row*columnCount + column] = RayTeXRefFromValue(BLANK_TEX);
+        }
+        va_end(args);
+        rUpdateRayTeXSharing(&element);
+        TRACELOG(LOG_DEBUG, "RAYTEX: TeX matrix with %i elements (%i rows x %i columns) generated successfully", elementCount, rowCount, columnCount);
+    }
+    else
+    {
+        TRACELOG(LOG_ERROR, "RAYTEX: GenRayTeXMatrix() failed to allocate");
+        va_list args;
+        va_start(args, fmt);
+        rUnloadRayTeXArgs(fmt, args);
+        va_end(args);
+    }
+    return element;
+}
+
+// Builds a horizontal, vertical or matrix element that owns copies of the given elements
+static RayTeX rGenRayTeXList(TeXMode mode, const RayTeX *elements, int count)
+{
+    RayTeX element = { 0 };
+    element.mode = mode;
+    RayTeXRef *content = rAllocShared(count * (sizeof(RayTeXRef) + sizeof(Vector2)));
+    if (content != NULL)
+    {
+        for (int i = 0; i < count; ++i) content[i] = RayTeXRefFromValue(elements[i]);
+        element.horizontal.elementCount = count;
+        element.horizontal.content = content;
+        element.horizontal.offsets = (Vector2 *)(content + count);
+        rUpdateRayTeXSharing(&element);
+    }
+    else
+    {
+        TRACELOG(LOG_ERROR, "RAYTEX: Failed to allocate %i elements", count);
+        for (int i = 0; i < count; ++i) UnloadRayTeX(elements[i]);
+    }
+    return element;
+}
+
+#define RAYTEX_PARSER_ROW_BREAK -1 // Mode of the marker left between matrix rows while parsing
+#define MAX_COMMAND_NAME_LENGTH 32
+
+typedef struct rParser {
+    const char *source;
+    const char *c;
+    RayTeX *stack;    // Elements of every group that is still open, innermost last
+    int stackCount;
+    int stackCapacity;
+    bool isFailed;    // Set when the stack could not grow, which stops the parser
+} rParser;
+
+// Returns false, and unloads the element, when the stack cannot grow. Parsing stops there, since the groups that
+// are still open would otherwise be collapsed without the elements that did not fit.
+static bool rParserPush(rParser *parser, RayTeX element)
+{
+    if (parser->stackCount == parser->stackCapacity)
+    {
+        int capacity = (parser->stackCapacity > 0) ? parser->stackCapacity*2 : 32;
+        RayTeX *stack = RL_REALLOC(parser->stack, capacity*sizeof(RayTeX));
+        if (stack == NULL)
+        {
+            TRACELOG(LOG_ERROR, "RAYTEX: ParseRayTeX() failed to allocate at offset %i", (int)(parser->c - parser->source));
+            if (element.mode != RAYTEX_PARSER_ROW_BREAK) UnloadRayTeX(element);
+            parser->isFailed = true;
+            return false;
+        }
+        parser->stack = stack;
+        parser->stackCapacity = capacity;
+    }
+    parser->stack[parser->stackCount++] = element;
+    return true;
+}
+
+// Replaces the elements from `start` on with a single element
+static void rParserCollapse(rParser *parser, int start)
+{
+    if (parser->isFailed) return;
+    int count = parser->stackCount - start;
+    RayTeX element = BLANK_TEX;
+    if (count == 1) element = parser->stack[start];
+    else if (count > 1) element = rGenRayTeXList(TEXMODE_HORIZONTAL, &parser->stack[start], count);
+    parser->stackCount = start;
+    rParserPush(parser, element);
+}
+
+// Replaces cells and row breaks from `start` on with a matrix, padding short rows with blank cells
+static void rParserCollapseMatrix(rParser *parser, int start)
+{
+    if (parser->isFailed) return;
+    int rowCount = 0;
+    int columnCount = 0;
+    int currentRowColumnCount = 0;
+    for (int i = start; i < parser->stackCount; ++i)
+    {
+        if (parser->stack[i].mode == RAYTEX_PARSER_ROW_BREAK)
+        {
+            ++rowCount;
+            currentRowColumnCount = 0;
+        }
+        else if (++currentRowColumnCount > columnCount) columnCount = currentRowColumnCount;
+    }
+    if (currentRowColumnCount > 0) ++rowCount; // A trailing \\ does not start an empty row
+
+    RayTeX element = { 0 };
+    element.mode = TEXMODE_MATRIX;
+    if (rAllocRayTeXMatrix(&element, rowCount, columnCount))
+    {
+        int row = 0;
+        int column = 0;
+        for (int i = start; i < parser->stackCount; ++i)
+        {
+            if (parser->stack[i].mode == RAYTEX_PARSER_ROW_BREAK)
+            {
+                for (; column < columnCount; ++column) element.matrix.content[row*columnCount + column] = RayTeXRefFromValue(BLANK_TEX);
+                ++row;
+                column = 0;
+            }
+            else element.matrix.content[row*columnCount + column++] = RayTeXRefFromValue(parser->stack[i]);
+        }
+        if (column > 0)
+        {
+            for (; column < columnCount; ++column) element.matrix.content[row*columnCount + column] = RayTeXRefFromValue(BLANK_TEX);
+        }
+        rUpdateRayTeXSharing(&element);
+    }
+    else
+    {
+        TRACELOG(LOG_ERROR, "RAYTEX: ParseRayTeX() failed to allocate");
+        for (int i = start; i < parser->stackCount; ++i)
+        {
+            if (parser->stack[i].mode != RAYTEX_PARSER_ROW_BREAK) UnloadRayTeX(parser->stack[i]);
+        }
+    }
+
+    parser->stackCount = start;
+    rParserPush(parser, element);
+}
+
+static void rParseRayTeXGroup(rParser *parser, bool isBraced);
+
+// Parses a braced group or a single token, as used for command arguments
+static void rParseRayTeXArgument(rParser *parser)
+{
+    if (parser->isFailed) return;
+    while ((*parser->c == ' ') || (*parser->c == '\t') || (*parser->c == '\n') || (*parser->c == '\r')) ++parser->c;
+
+    int start = parser->stackCount;
+    if (*parser->c == '{')
+    {
+        ++parser->c;
+        rParseRayTeXGroup(parser, true);
+    }
+    else if ((*parser->c != '\0') && (*parser->c != '}'))
+    {
+        RayTeX element = { 0 };
+        element.mode = TEXMODE_TEXT;
+        element.text.content = parser->c;
+        element.text.length = 1;
+        rDecodeRayTeXText(&element);
+        ++parser->c;
+        rParserPush(parser, element);
+    }
+    else TRACELOG(LOG_WARNING, "RAYTEX: ParseRayTeX() at offset %i: missing argument", (int)(parser->c - parser->source));
+
+    rParserCollapse(parser, start);
+}
+
+static bool rIsRayTeXCommandLetter(char c)
+{
+    return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z'));
+}
+
+static void rParseRayTeXCommand(rParser *parser)
+{
+    const char *name = parser->c;
+    int length = 0;
+    if (rIsRayTeXCommandLetter(*name))
+    {
+        while (rIsRayTeXCommandLetter(name[length])) ++length;
+    }
+    else if (*name != '\0') length = 1; // Control symbols like \, are a single character
+    parser->c += length;
+
+    if (length == 1)
+    {
+        switch (*name)
+        {
+        case ',': rParserPush(parser, THINSPACE); return;
+        case ':':
+        case '>': rParserPush(parser, BINSPACE);  return;
+        case ';': rParserPush(parser, RELSPACE);  return;
+        case '!': rParserPush(parser, EXSPACE);   return;
+        case ' ': rParserPush(parser, THINSPACE); return;
+        default: break;
+        }
+    }
+
+    char buffer[MAX_COMMAND_NAME_LENGTH] = { 0 };
+    if (length >= MAX_COMMAND_NAME_LENGTH)
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: ParseRayTeX() at offset %i: command name is too long", (int)(name - parser->source));
+        return;
+    }
+    memcpy(buffer, name, length);
+
+    if (TextIsEqual(buffer, "frac"))
+    {
+        int start = parser->stackCount;
+        rParseRayTeXArgument(parser);
+        rParseRayTeXArgument(parser);
+        if (parser->isFailed) return;
+        RayTeX element = { 0 };
+        element.mode = TEXMODE_FRAC;
+        element.frac.content[TEX_FRAC_NUMERATOR] = RayTeXRefFromValue(parser->stack[start]);
+        element.frac.content[TEX_FRAC_DENOMINATOR] = RayTeXRefFromValue(parser->stack[start + 1]);
+        rUpdateRayTeXSharing(&element);
+        parser->stackCount = start;
+        rParserPush(parser, element);
+    }
+    else if (TextIsEqual(buffer, "quad")) rParserPush(parser, QUAD);
+    else if (TextIsEqual(buffer, "qquad")) rParserPush(parser, QQUAD);
+    else if (TextIsEqual(buffer, "thinspace")) rParserPush(parser, THINSPACE);
+    else if (TextIsEqual(buffer, "medspace")) rParserPush(parser, BINSPACE);
+    else if (TextIsEqual(buffer, "thickspace")) rParserPush(parser, RELSPACE);
+    else if (TextIsEqual(buffer, "negthinspace")) rParserPush(parser, EXSPACE);
+    else if (TextIsEqual(buffer, "slot"))
+    {
+        // The name is taken as it is, not parsed
+        while (*parser->c == ' ') ++parser->c;
+        if (*parser->c != '{')
+        {
+            TRACELOG(LOG_WARNING, "RAYTEX: ParseRayTeX() at offset %i: \\slot needs a braced name", (int)(parser->c - parser->source));
+            return;
+        }
+        const char *slotName = ++parser->c;
+        while ((*parser->c != '\0') && (*parser->c != '}')) ++parser->c;
+        RayTeX element = { 0 };
+        element.mode = TEXMODE_TEXT;
+        element.isSlot = true;
+        element.text.content = slotName;
+        element.text.length = (int)(parser->c - slotName);
+        if (element.text.length == 0) element.text.content = ""; // A length of 0 would mean null-terminated
+        rDecodeRayTeXText(&element);
+        if (*parser->c == '}') ++parser->c;
+        rParserPush(parser, element);
+    }
+    else
+    {
+        RayTeXSymbol symbol = rRayTeXSymbolFromName(name, length);
+        if (symbol != TEXSYMBOL_UNKNOWN) rParserPush(parser, GenRayTeXSymbol(symbol));
+    }
+}
+
+// Parses elements until the end of the group, leaving a single element for the whole group on the stack
+static void rParseRayTeXGroup(rParser *parser, bool isBraced)
+{
+    int groupStart = parser->stackCount;
+    int cellStart = groupStart;
+    bool isMatrix = false;
+    bool isClosed = false;
+
+    while ((*parser->c != '\0') && !parser->isFailed)
+    {
+        char c = *parser->c;
+        if ((c == ' ') || (c == '\t') || (c == '\n') || (c == '\r'))
+        {
+            ++parser->c; // Whitespace is insignificant, as in TeX math mode
+        }
+        else if (c == '}')
+        {
+            ++parser->c;
+            if (isBraced)
+            {
+                isClosed = true;
+                break;
+            }
+            TRACELOG(LOG_WARNING, "RAYTEX: ParseRayTeX() at offset %i: unmatched '}'", (int)(parser->c - parser->source - 1));
+        }
+        else if (c == '{')
+        {
+            ++parser->c;
+            rParseRayTeXGroup(parser, true);
+        }
+        else if ((c == '&') || ((c == '\\') && (parser->c[1] == '\\')))
+        {
+            parser->c += (c == '&') ? 1 : 2;
+            rParserCollapse(parser, cellStart);
+            if (c == '\\')
+            {
+                RayTeX rowBreak = { 0 };
+                rowBreak.mode = RAYTEX_PARSER_ROW_BREAK;
+                rParserPush(parser, rowBreak);
+            }
+            cellStart = parser->stackCount;
+            isMatrix = true;
+        }
+        else if (c == '\\')
+        {
+            ++parser->c;
+            rParseRayTeXCommand(parser);
+        }
+        else
+        {
+            // Text runs until the next character with a meaning of its own
+            RayTeX element = { 0 };
+            element.mode = TEXMODE_TEXT;
+            element.text.content = parser->c;
+            while ((*parser->c != '\0') && (strchr(" \t\n\r{}&\\", *parser->c) == NULL)) ++parser->c;
+            element.text.length = (int)(parser->c - element.text.content);
+            rDecodeRayTeXText(&element);
+            rParserPush(parser, element);
+        }
+    }
+    if (isBraced && !isClosed && !parser->isFailed) TRACELOG(LOG_WARNING, "RAYTEX: ParseRayTeX() reached the end of the source with an unclosed '{'");
+
+    if (isMatrix)
+    {
+        if (parser->stackCount > cellStart) rParserCollapse(parser, cellStart);
+        rParserCollapseMatrix(parser, groupStart);
+    }
+    else rParserCollapse(parser, groupStart);
+}
+
+RayTeX ParseRayTeX(const char *source)
+{
+    rParser parser = { 0 };
+    parser.source = source;
+    parser.c = source;
+    rParseRayTeXGroup(&parser, false);
+
+    RayTeX element = BLANK_TEX;
+    if (parser.isFailed)
+    {
+        for (int i = 0; i < parser.stackCount; ++i)
+        {
+            if (parser.stack[i].mode != RAYTEX_PARSER_ROW_BREAK) UnloadRayTeX(parser.stack[i]);
+        }
+    }
+    else
+    {
+        if (parser.stackCount > 0) element = parser.stack[0];
+        TRACELOG(LOG_DEBUG, "RAYTEX: TeX parsed successfully");
+    }
+    RL_FREE(parser.stack);
+    return element;
+}
+
+static void UnloadAndFreeRayTeXRefIfOwned(RayTeXRef ref)
+{
+    // Children still referenced by a clone stay loaded for it, and are linked again by whichever parent is laid out next
+    if (ref.isOwned && (--ref.ptr->refCount > 0))
+    {
+        ref.ptr->parent = NULL;
+        return;
+    }
+    if (ref.isOwned)
+    {
+        UnloadRayTeX(*ref.ptr);
+        RAYTEX_FREE(ref.ptr);
+        RAYTEX_STATS_ADD(liveNodeCount, -1);
+    }
+    else TRACELOG(LOG_DEBUG, "RAYTEX: potentially-shared child visited during unloading process has not been unloaded");
+}
+
+// Releases the element's reference to its child array, and with the last one the children
+static void rReleaseRayTeXChildren(const RayTeX *tex)
+{
+    int childCount = 0;
+    Vector2 *offsets = NULL;
+    RayTeXRef *children = rGetRayTeXChildren(tex, &childCount, &offsets);
+    if (children == NULL) return;
+    if (!rIsShared(children))
+    {
+        for (int i = 0; i < childCount; ++i) UnloadAndFreeRayTeXRefIfOwned(children[i]);
+    }
+    rReleaseShared(children);
+}
+
+void UnloadRayTeX(RayTeX tex)
+{
+    RAYTEX_FREE(tex.overrideFont);
+    RL_FREE(tex.layout.sharedLayouts);
+    switch (tex.mode)
+    {
+    case TEXMODE_SPACE:
+        TRACELOG(LOG_DEBUG, "RAYTEX: TeX horizontal space element unloaded successfully");
+        break;
+
+    case TEXMODE_VSPACE:
+        TRACELOG(LOG_DEBUG, "RAYTEX: TeX vertical space element unloaded successfully");
+        break;
+
+    case TEXMODE_TEXT:
+        if (tex.text.isOwned) rReleaseShared(tex.text.content);
+        rFreeRayTeXTextBuffers(&tex);
+        TRACELOG(LOG_DEBUG, "RAYTEX: TeX text element unloaded successfully");
+        break;
+
+    case TEXMODE_SYMBOL:
+        TRACELOG(LOG_DEBUG, "RAYTEX: TeX symbol element unloaded successfully");
+        break;
+
+    case TEXMODE_FRAC:
+        UnloadAndFreeRayTeXRefIfOwned(tex.frac.content[TEX_FRAC_NUMERATOR]);
+        UnloadAndFreeRayTeXRefIfOwned(tex.frac.content[TEX_FRAC_DENOMINATOR]);
+        TRACELOG(LOG_DEBUG, "RAYTEX: TeX fraction element unloaded successfully");
+        break;
+
+    case TEXMODE_HORIZONTAL:
+        rReleaseRayTeXChildren(&tex);
+        TRACELOG(LOG_DEBUG, "RAYTEX: TeX horizontal element unloaded successfully");
+        break;
+
+    case TEXMODE_VERTICAL:
+        rReleaseRayTeXChildren(&tex);
+        TRACELOG(LOG_DEBUG, "RAYTEX: TeX vertical element unloaded successfully");
+        break;
+
+    case TEXMODE_MATRIX:
+        rReleaseRayTeXChildren(&tex);
+        TRACELOG(LOG_DEBUG, "RAYTEX: TeX matrix element unloaded successfully");
+        break;
+
+    default: TRACELOG(LOG_WARNING, "RAYTEX: Failed to unload TeX element with unknown mode [%i]", tex.mode);
+    }
+}
+
+// Box in pixels and child offsets of an element that has been laid out with its own font and font size, without changing it.
+// Offsets are in the layout's units, which scale multiplies into pixels.
+// Interned elements may currently hold their layout for another font or font size, with this one kept aside.
+static RayTeXBox rGetLaidOutBox(const RayTeX *tex, const void *fontId, float fontSize, const Vector2 **offsets, float *scale)
+{
+    int childCount = 0;
+    Vector2 *childOffsets = NULL;
+    rGetRayTeXChildren(tex, &childCount, &childOffsets);
+    *offsets = childOffsets;
+    if (tex->isInterned && !rIsLayoutFor(&tex->layout, fontId, fontSize))
+    {
+        const rSharedLayout *shared = rFindSharedLayout(tex, fontId, fontSize);
+        if (shared != NULL)
+        {
+            *offsets = shared->offsets;
+            *scale = shared->isScaleFree ? fontSize : 1.0f;
+            return rScaleBox(shared->box, *scale);
+        }
+    }
+    *scale = tex->layout.isScaleFree ? fontSize : 1.0f;
+    return rScaleBox(tex->layout.box, *scale);
+}
+
+static int pixelSnapFontSize = 0; // Font size at or below which drawing snaps to whole pixels, 0 to never snap
+
+void SetRayTeXPixelSnap(int fontSize)
+{
+    pixelSnapFontSize = fontSize;
+}
+
+// Layouts scale to any font size, so positions fall between pixels. At small sizes, where being off by a fraction
+// of a pixel shows, glyphs and rules are moved to whole pixels. Only what is drawn is rounded, never the positions
+// children are placed from, so rounding does not add up down the tree.
+static Vector2 rSnapToPixel(Vector2 position, float fontSize)
+{
+    if (fontSize > (float)pixelSnapFontSize) return position;
+    position.x = floorf(position.x + 0.5f);
+    position.y = floorf(position.y + 0.5f);
+    return position;
+}
+
+// Where a child of an ordered element begins along the element's axis, in layout units. Matrices are ordered by row,
+// and a row begins with its tallest cell.
+static float rGetChildStart(const RayTeX *tex, const Vector2 *offsets, int index)
+{
+    if (tex->mode == TEXMODE_HORIZONTAL) return offsets[index].x;
+    if (tex->mode == TEXMODE_VERTICAL) return offsets[index].y;
+
+    float start = offsets[index*tex->matrix.columnCount].y;
+    for (int column = 1; column < tex->matrix.columnCount; ++column)
+    {
+        if (offsets[index*tex->matrix.columnCount + column].y < start) start = offsets[index*tex->matrix.columnCount + column].y;
+    }
+    return start;
+}
+
+// Children of an ordered element, or rows of a matrix, that can reach into the rectangle. Each one ends where the
+// next begins, so both ends of the range are found by bisecting the cached offsets instead of testing every child.
+static void rGetChildrenInRec(const RayTeX *tex, const Vector2 *offsets, Vector2 position, float scale, float margin, const Rectangle *rec, int *first, int *last)
+{
+    int count = (tex->mode == TEXMODE_HORIZONTAL) ? tex->horizontal.elementCount :
+                (tex->mode == TEXMODE_VERTICAL) ? tex->vertical.elementCount : tex->matrix.rowCount;
+    *first = 0;
+    *last = count;
+    if ((rec == NULL) || !tex->layout.isOrdered || (scale <= 0.0f) || (count == 0)) return;
+
+    bool isHorizontal = (tex->mode == TEXMODE_HORIZONTAL);
+    float start = isHorizontal ? (rec->x - margin - position.x)/scale : (rec->y - margin - position.y)/scale;
+    float end = isHorizontal ? (rec->x + rec->width + margin - position.x)/scale : (rec->y + rec->height + margin - position.y)/scale;
+
+    // First child that does not end before the rectangle starts
+    int low = 0;
+    int high = count - 1;
+    while (low < high)
+    {
+        int middle = (low + high)/2;
+        if (rGetChildStart(tex, offsets, middle + 1) < start) low = middle + 1;
+        else high = middle;
+    }
+    *first = low;
+
+    // First child that starts after the rectangle ends
+    high = count;
+    while (low < high)
+    {
+        int middle = (low + high)/2;
+        if (rGetChildStart(tex, offsets, middle) > end) high = middle;
+        else low = middle + 1;
+    }
+    *last = high;
+}
+
+// Same as rGetChildrenInRec(), counting the children that drawing skips
+static void rGetVisibleChildren(const RayTeX *tex, const Vector2 *offsets, Vector2 position, float scale, float margin, const Rectangle *viewport, int *first, int *last)
+{
+    rGetChildrenInRec(tex, offsets, position, scale, margin, viewport, first, last);
+    int count = (tex->mode == TEXMODE_HORIZONTAL) ? tex->horizontal.elementCount :
+                (tex->mode == TEXMODE_VERTICAL) ? tex->vertical.elementCount : tex->matrix.rowCount;
+    int skipped = *first + count - *last;
+    if (tex->mode == TEXMODE_MATRIX) skipped *= tex->matrix.columnCount;
+    RAYTEX_STATS_ADD(drawCulledCount, skipped);
+}
+
+// Draws an element that has already been laid out by rLayoutRayTeX() with the same font and font size.
+// With a viewport, elements whose box is outside of it are skipped together with everything below them.
+static void rDrawRayTeX(const rDrawSink *sink, const Font *font, const RayTeX *tex, Vector2 position, float fontSize, const Color *color, const Rectangle *viewport)
+{
+    if (tex->isOverridingColor) color = &tex->overrideColor;
+    if (tex->isOverridingFontSize) fontSize = (float)tex->overrideFontSize;
+    if (tex->overrideFont != NULL) font = tex->overrideFont;
+    RAYTEX_STATS_ADD(drawNodeCount, 1);
+
+    const Vector2 *offsets = NULL;
+    float scale = 1.0f;
+    RayTeXBox box = rGetLaidOutBox(tex, font->glyphs, fontSize, &offsets, &scale);
+
+    // Children are always placed inside their parent's box, so the cached box bounds the whole subtree.
+    // Glyphs can reach a little past their advance, which the margin covers.
+    if (viewport != NULL)
+    {
+        float margin = MU_TO_PIXELS((float)RAYTEX_CLIP_MARGIN, fontSize);
+        Rectangle bounds = { position.x - margin, position.y - margin, box.width + 2.0f*margin, box.height + box.depth + 2.0f*margin };
+        if ((bounds.x > viewport->x + viewport->width) || (bounds.x + bounds.width < viewport->x) ||
+            (bounds.y > viewport->y + viewport->height) || (bounds.y + bounds.height < viewport->y))
+        {
+            RAYTEX_STATS_ADD(drawCulledCount, 1);
+            return;
+        }
+
+        // Nothing below an element that is entirely visible needs testing
+        if ((bounds.x >= viewport->x) && (bounds.x + bounds.width <= viewport->x + viewport->width) &&
+            (bounds.y >= viewport->y) && (bounds.y + bounds.height <= viewport->y + viewport->height)) viewport = NULL;
+    }
+
+    // boxes around everything
+#if 0
+    DrawRectangleLines(position.x, position.y, box.width, box.height + box.depth, MAGENTA);
+#endif
+
+    switch (tex->mode)
+    {
+    case TEXMODE_SPACE:
+    case TEXMODE_VSPACE:
+        break;
+
+    case TEXMODE_TEXT:
+        position = rSnapToPixel(position, fontSize);
+        if ((sink->DrawGlyphRun != NULL) && rIsTextShapedFor(tex, font->glyphs))
+        {
+            sink->DrawGlyphRun(sink->userData, font, tex->text.glyphIndices, tex->text.glyphOffsets, tex->text.codepointCount, position, fontSize, color);
+        }
+        else sink->DrawText(sink->userData, font, rTextContent(tex), tex->text.length, position, fontSize, color);
+        break;
+
+    case TEXMODE_SYMBOL:
+    {
+        Vector2 size = { box.width, box.height + box.depth };
+        rDrawRayTeXSymbol(sink, font, tex->symbol.content, rSnapToPixel(position, fontSize), size, fontSize, color);
+    }
+        break;
+
+    case TEXMODE_FRAC:
+    {
+        const RayTeX *numerator = tex->frac.content[TEX_FRAC_NUMERATOR].ptr;
+        const RayTeX *denominator = tex->frac.content[TEX_FRAC_DENOMINATOR].ptr;
+
+        Vector2 numeratorPosition = { 0 };
+        numeratorPosition.x = position.x + offsets[TEX_FRAC_NUMERATOR].x*scale;
+        numeratorPosition.y = position.y + offsets[TEX_FRAC_NUMERATOR].y*scale;
+        rDrawRayTeX(sink, font, numerator, numeratorPosition, fontSize, color, viewport);
+
+        Rectangle ruleRec = rFracRule(box, position, fontSize);
+        if (fontSize <= (float)pixelSnapFontSize)
+        {
+            ruleRec.x = floorf(ruleRec.x + 0.5f);
+            ruleRec.height = (ruleRec.height < 1.0f) ? 1.0f : floorf(ruleRec.height + 0.5f);
+            ruleRec.y = floorf(ruleRec.y + 0.5f);
+            ruleRec.width = floorf(ruleRec.width + 0.5f);
+        }
+        sink->DrawRule(sink->userData, font, ruleRec, color);
+
+        Vector2 denominatorPosition = { 0 };
+        denominatorPosition.x = position.x + offsets[TEX_FRAC_DENOMINATOR].x*scale;
+        denominatorPosition.y = position.y + offsets[TEX_FRAC_DENOMINATOR].y*scale;
+        rDrawRayTeX(sink, font, denominator, denominatorPosition, fontSize, color, viewport);
+    }
+        break;
+
+    case TEXMODE_HORIZONTAL:
+    {
+        int first = 0;
+        int last = 0;
+        rGetVisibleChildren(tex, offsets, position, scale, MU_TO_PIXELS((float)RAYTEX_CLIP_MARGIN, fontSize), viewport, &first, &last);
+        for (int i = first; i < last; ++i)
+        {
+            Vector2 elementPosition = { 0 };
+            elementPosition.x = position.x + offsets[i].x*scale;
+            elementPosition.y = position.y + offsets[i].y*scale;
+            rDrawRayTeX(sink, font, tex->horizontal.content[i].ptr, elementPosition, fontSize, color, viewport);
+        }
+    }
+        break;
+
+    case TEXMODE_VERTICAL:
+    {
+        int first = 0;
+        int last = 0;
+        rGetVisibleChildren(tex, offsets, position, scale, MU_TO_PIXELS((float)RAYTEX_CLIP_MARGIN, fontSize), viewport, &first, &last);
+        for (int i = first; i < last; ++i)
+        {
+            Vector2 elementPosition = { 0 };
+            elementPosition.x = position.x + offsets[i].x*scale;
+            elementPosition.y = position.y + offsets[i].y*scale;
+            rDrawRayTeX(sink, font, tex->vertical.content[i].ptr, elementPosition, fontSize, color, viewport);
+        }
+    }
+        break;
+
+    case TEXMODE_MATRIX:
+    {
+        int firstRow = 0;
+        int lastRow = 0;
+        rGetVisibleChildren(tex, offsets, position, scale, MU_TO_PIXELS((float)RAYTEX_CLIP_MARGIN, fontSize), viewport, &firstRow, &lastRow);
+        for (int i = firstRow*tex->matrix.columnCount; i < lastRow*tex->matrix.columnCount; ++i)
+        {
+            Vector2 elementPosition = { 0 };
+            elementPosition.x = position.x + offsets[i].x*scale;
+            elementPosition.y = position.y + offsets[i].y*scale;
+            rDrawRayTeX(sink, font, tex->matrix.content[i].ptr, elementPosition, fontSize, color, viewport);
+        }
+    }
+        break;
+
+    default: TRACELOG(LOG_WARNING, "RAYTEX: Unknown mode [%i]", tex->mode);
+    }
+}
+
+void DrawRayTeX(RayTeX tex, int x, int y, int fontSize, Color color)
+{
+    DrawRayTeXEx(GetFontDefault(), tex, x, y, fontSize, color);
+}
+
+// Draws a root laid out where it is, skipping subtrees outside the viewport unless it is NULL
+static void rDrawRayTeXRoot(const Font *font, RayTeX *tex, int x, int y, int fontSize, Color color, const Rectangle *viewport, bool isKept)
+{
+    Vector2 position = { 0 };
+    position.x = (float)x;
+    position.y = (float)y;
+    RAYTEX_STATS_BEGIN("DrawRayTeX");
+    rLayoutRayTeXTree(font, tex, (float)fontSize, isKept);
+    rDrawRayTeX(&raylibDrawSink, font, tex, position, (float)fontSize, &color, viewport);
+    RAYTEX_STATS_END("DrawRayTeX", drawTime);
+}
+
+void DrawRayTeXEx(Font font, RayTeX tex, int x, int y, int fontSize, Color color)
+{
+    rDrawRayTeXRoot(&font, &tex, x, y, fontSize, color, NULL, false);
+}
+
+void DrawRayTeXClipped(Font font, RayTeX tex, int x, int y, int fontSize, Color color, Rectangle viewport)
+{
+    rDrawRayTeXRoot(&font, &tex, x, y, fontSize, color, &viewport, false);
+}
+
+RayTeXBox LayoutRayTeX(Font font, RayTeX *tex, int fontSize)
+{
+    RAYTEX_STATS_BEGIN("MeasureRayTeX");
+    rLayoutRayTeXTree(&font, tex, (float)fontSize, true);
+    RAYTEX_STATS_END("MeasureRayTeX", measureTime);
+    return rGetLayoutBox(tex, (float)fontSize);
+}
+
+void DrawRayTeXLayout(Font font, RayTeX *tex, int x, int y, int fontSize, Color color)
+{
+    rDrawRayTeXRoot(&font, tex, x, y, fontSize, color, NULL, true);
+}
+
+void DrawRayTeXLayoutClipped(Font font, RayTeX *tex, int x, int y, int fontSize, Color color, Rectangle viewport)
+{
+    rDrawRayTeXRoot(&font, tex, x, y, fontSize, color, &viewport, true);
+}
+
+// Font and font size an element is laid out with, given the ones it inherits
+static void rGetElementContext(const RayTeX *tex, const Font **font, float *fontSize)
+{
+    if (tex->isOverridingFontSize) *fontSize = (float)tex->overrideFontSize;
+    if (tex->overrideFont != NULL) *font = tex->overrideFont;
+}
+
+static Rectangle rBoxRec(RayTeXBox box, Vector2 position)
+{
+    Rectangle rec = { position.x, position.y, box.width, box.height + box.depth };
+    return rec;
+}
+
+// Every element's box holds its children's, so the cached layout is a bounding volume hierarchy that
+// incremental layout keeps current. Picking descends it, testing only the children of elements under the point.
+RayTeXPick PickRayTeX(Font font, RayTeX *tex, int x, int y, int fontSize, Vector2 point)
+{
+    RayTeXPick pick = { 0 };
+    pick.depth = -1;
+    rLayoutRayTeXTree(&font, tex, (float)fontSize, true);
+    RayTeX *element = tex;
+    const Font *elementFont = &font;
+    float elementFontSize = (float)fontSize;
+    rGetElementContext(element, &elementFont, &elementFontSize);
+    Vector2 position = { (float)x, (float)y };
+    const Vector2 *offsets = NULL;
+    float scale = 1.0f;
+    Rectangle rec = rBoxRec(rGetLaidOutBox(element, elementFont->glyphs, elementFontSize, &offsets, &scale), position);
+    if (!CheckCollisionPointRec(point, rec)) return pick;
+
+    pick.depth = 0;
+    pick.elements[0] = tex;
+    pick.rec = rec;
+    while (pick.depth < RAYTEX_MAX_PICK_DEPTH)
+    {
+        int childCount = 0;
+        Vector2 *unusedOffsets = NULL;
+        RayTeXRef *children = rGetRayTeXChildren(element, &childCount, &unusedOffsets);
+
+        // Only the children of ordered lists that reach the point are tested
+        int first = 0;
+        int last = childCount;
+        if ((element->mode == TEXMODE_HORIZONTAL) || (element->mode == TEXMODE_VERTICAL))
+        {
+            Rectangle pointRec = { point.x, point.y, 1.0f, 1.0f };
+            rGetChildrenInRec(element, offsets, position, scale, 0.0f, &pointRec, &first, &last);
+        }
+
+        // Later children are drawn over earlier ones, so they are tested first
+        int hit = -1;
+        for (int i = last - 1; (i >= first) && (hit < 0); --i)
+        {
+            const Font *childFont = elementFont;
+            float childFontSize = elementFontSize;
+            rGetElementContext(children[i].ptr, &childFont, &childFontSize);
+            Vector2 childPosition = { position.x + offsets[i].x*scale, position.y + offsets[i].y*scale };
+            const Vector2 *childOffsets = NULL;
+            float childScale = 1.0f;
+            Rectangle childRec = rBoxRec(rGetLaidOutBox(children[i].ptr, childFont->glyphs, childFontSize, &childOffsets, &childScale), childPosition);
+            if (CheckCollisionPointRec(point, childRec))
+            {
+                hit = i;
+                element = children[i].ptr;
+                elementFont = childFont;
+                elementFontSize = childFontSize;
+                position = childPosition;
+                offsets = childOffsets;
+                scale = childScale;
+                rec = childRec;
+            }
+        }
+        if (hit < 0) break;
+
+        pick.indices[pick.depth++] = hit;
+        pick.elements[pick.depth] = element;
+        pick.rec = rec;
+    }
+    return pick;
+}
+
+Rectangle GetRayTeXRec(Font font, RayTeX *tex, int x, int y, int fontSize, const int *indices, int depth)
+{
+    Rectangle rec = { 0 };
+    rLayoutRayTeXTree(&font, tex, (float)fontSize, true);
+    const RayTeX *element = tex;
+    const Font *elementFont = &font;
+    float elementFontSize = (float)fontSize;
+    Vector2 position = { (float)x, (float)y };
+    for (int level = 0; level < depth; ++level)
+    {
+        rGetElementContext(element, &elementFont, &elementFontSize);
+        const Vector2 *offsets = NULL;
+        float scale = 1.0f;
+        rGetLaidOutBox(element, elementFont->glyphs, elementFontSize, &offsets, &scale);
+        int childCount = 0;
+        Vector2 *unusedOffsets = NULL;
+        RayTeXRef *children = rGetRayTeXChildren(element, &childCount, &unusedOffsets);
+        if ((indices[level] < 0) || (indices[level] >= childCount))
+        {
+            TRACELOG(LOG_WARNING, "RAYTEX: GetRayTeXRec() child index %i out of range at level %i", indices[level], level);
+            return rec;
+        }
+        position.x += offsets[indices[level]].x*scale;
+        position.y += offsets[indices[level]].y*scale;
+        element = children[indices[level]].ptr;
+    }
+
+    rGetElementContext(element, &elementFont, &elementFontSize);
+    const Vector2 *offsets = NULL;
+    float scale = 1.0f;
+    return rBoxRec(rGetLaidOutBox(element, elementFont->glyphs, elementFontSize, &offsets, &scale), position);
+}
+
+// Follows the texture and primitive mode that the raylib sink would leave rlgl in, without drawing
+typedef struct rBatchCounter {
+    unsigned int textureId;
+    int mode;
+    int primitiveCount;
+    int batchBreaks;
+} rBatchCounter;
+
+static void rCountBatchState(rBatchCounter *counter, unsigned int textureId, int mode)
+{
+    if ((counter->primitiveCount > 0) && ((counter->textureId != textureId) || (counter->mode != mode))) counter->batchBreaks++;
+    counter->textureId = textureId;
+    counter->mode = mode;
+    counter->primitiveCount++;
+}
+
+static void rCountText(void *userData, const Font *font, const char *text, int length, Vector2 position, float fontSize, const Color *color)
+{
+    rCountBatchState(userData, font->texture.id, RL_QUADS);
+}
+
+static void rCountGlyphRun(void *userData, const Font *font, const int *glyphIndices, const float *glyphOffsets, int glyphCount, Vector2 position, float fontSize, const Color *color)
+{
+    rCountBatchState(userData, font->texture.id, RL_QUADS);
+}
+
+static void rCountRule(void *userData, const Font *font, Rectangle rec, const Color *color)
+{
+    if (rGetWhiteTexel(*font) != NULL) rCountBatchState(userData, font->texture.id, RL_QUADS);
+    else rCountBatchState(userData, GetShapesTexture().id, RL_QUADS);
+}
+
+static void rCountLine(void *userData, const Font *font, Vector2 startPos, Vector2 endPos, const Color *color)
+{
+    if (rGetWhiteTexel(*font) != NULL) rCountBatchState(userData, font->texture.id, RL_QUADS);
+    else rCountBatchState(userData, 0, RL_LINES);
+}
+
+int CountRayTeXBatchBreaks(Font font, RayTeX tex, int fontSize)
+{
+    rBatchCounter counter = { 0 };
+    rDrawSink sink = { &counter, rCountText, rCountGlyphRun, rCountRule, rCountLine };
+    Vector2 position = { 0 };
+    Color color = { 0 };
+    rLayoutRayTeXTree(&font, &tex, (float)fontSize, false);
+    rDrawRayTeX(&sink, &font, &tex, position, (float)fontSize, &color, NULL);
+    return counter.batchBreaks;
+}
+
+// Draws into an Image on the CPU, so it needs no window
+// Glyphs come from the glyph images and are looked up without the glyph cache, so that images can be drawn from several threads
+static void rImageDrawGlyph(Image *dst, const Font *font, int index, Vector2 position, float fontSize, Color tint)
+{
+    Image glyph = font->glyphs[index].image;
+    if (glyph.data == NULL) return;
+
+    float scaleFactor = fontSize / (float)font->baseSize;
+    Rectangle srcRec = { 0.0f, 0.0f, (float)glyph.width, (float)glyph.height };
+    Rectangle dstRec = { position.x + (float)font->glyphs[index].offsetX*scaleFactor, position.y + (float)font->glyphs[index].offsetY*scaleFactor,
+                         (float)glyph.width*scaleFactor, (float)glyph.height*scaleFactor };
+    ImageDraw(dst, glyph, srcRec, dstRec, tint);
+}
+
+static void rImageDrawText(void *userData, const Font *font, const char *text, int length, Vector2 position, float fontSize, const Color *color)
+{
+    if (length == 0) length = (int)strlen(text);
+    float scaleFactor = fontSize / (float)font->baseSize;
+    float textOffsetX = 0.0f;
+    for (int i = 0; i < length;)
+    {
+        int codepointByteCount = 0;
+        int codepoint = GetCodepointNext(&text[i], &codepointByteCount);
+        int index = GetGlyphIndex(*font, codepoint);
+        if ((codepoint != ' ') && (codepoint != '\t'))
+        {
+            Vector2 glyphPosition = { position.x + textOffsetX, position.y };
+            rImageDrawGlyph(userData, font, index, glyphPosition, fontSize, *color);
+        }
+        textOffsetX += rGlyphDrawAdvance(*font, index)*scaleFactor + fontSize / 10;
+        i += codepointByteCount;
+    }
+}
+
+static void rImageDrawGlyphRun(void *userData, const Font *font, const int *glyphIndices, const float *glyphOffsets, int glyphCount, Vector2 position, float fontSize, const Color *color)
+{
+    float scaleFactor = fontSize / (float)font->baseSize;
+    float spacing = fontSize / 10;
+    for (int i = 0; i < glyphCount; ++i)
+    {
+        if (glyphIndices[i] < 0) continue;
+        Vector2 glyphPosition = { position.x + glyphOffsets[i]*scaleFactor + (float)i*spacing, position.y };
+        rImageDrawGlyph(userData, font, glyphIndices[i], glyphPosition, fontSize, *color);
+    }
+}
+
+static void rImageDrawRule(void *userData, const Font *font, Rectangle rec, const Color *color)
+{
+    ImageDrawRectangleRec(userData, rec, *color);
+}
+
+static void rImageDrawLine(void *userData, const Font *font, Vector2 startPos, Vector2 endPos, const Color *color)
+{
+    ImageDrawLineV(userData, startPos, endPos, *color);
+}
+
+// Renders an element that has already been laid out, on a transparent image just large enough to hold it
+static Image rRenderRayTeXToImage(const Font *font, const RayTeX *tex, float fontSize, Color color)
+{
+    RayTeXBox box = rGetLayoutBox(tex, fontSize);
+    int width = (int)ceilf(box.width);
+    int height = (int)ceilf(box.height + box.depth);
+    Image image = GenImageColor((width > 0) ? width : 1, (height > 0) ? height : 1, BLANK);
+    if (image.data != NULL)
+    {
+        rDrawSink sink = { &image, rImageDrawText, rImageDrawGlyphRun, rImageDrawRule, rImageDrawLine };
+        Vector2 position = { 0 };
+        rDrawRayTeX(&sink, font, tex, position, fontSize, &color, NULL);
+    }
+    return image;
+}
+
+Image RenderRayTeXToImage(Font font, RayTeX tex, int fontSize, Color color)
+{
+    rLayoutRayTeXTree(&font, &tex, (float)fontSize, false);
+    return rRenderRayTeXToImage(&font, &tex, (float)fontSize, color);
+}
+
+typedef struct rExportBatch {
+    const Font *font;
+    RayTeX *texs;
+    const char **fileNames;
+    int count;
+    float fontSize;
+    Color color;
+    int nextIndex;   // Next formula to be taken by a worker
+    int failedCount;
+#if defined(RAYTEX_THREADS)
+    mtx_t lock;
+    bool isLocking;  // Only while workers run in parallel
+#endif
+} rExportBatch;
+
+static void rLockExportBatch(rExportBatch *batch)
+{
+#if defined(RAYTEX_THREADS)
+    if (batch->isLocking) mtx_lock(&batch->lock);
+#endif
+}
+
+static void rUnlockExportBatch(rExportBatch *batch)
+{
+#if defined(RAYTEX_THREADS)
+    if (batch->isLocking) mtx_unlock(&batch->lock);
+#endif
+}
+
+// Formulas are handed out one at a time - each one is big enough that taking the lock does not matter
+static int rTakeExportIndex(rExportBatch *batch)
+{
+    rLockExportBatch(batch);
+    int index = (batch->nextIndex < batch->count) ? batch->nextIndex++ : -1;
+    rUnlockExportBatch(batch);
+    return index;
+}
+
+static int rExportWorker(void *arg)
+{
+    rExportBatch *batch = arg;
+#if defined(RAYTEX_STATS) && defined(RAYTEX_THREADS)
+    RayTeXStats workerStats = { 0 };
+    RayTeXStats *previousStats = threadStats;
+    threadStats = &workerStats;
+#endif
+    for (int index = rTakeExportIndex(batch); index >= 0; index = rTakeExportIndex(batch))
+    {
+        Image image = rRenderRayTeXToImage(batch->font, &batch->texs[index], batch->fontSize, batch->color);
+        bool isExported = (image.data != NULL) && ExportImage(image, batch->fileNames[index]);
+        UnloadImage(image);
+        if (!isExported)
+        {
+            TRACELOG(LOG_WARNING, "RAYTEX: [%s] Failed to export formula %i", batch->fileNames[index], index);
+            rLockExportBatch(batch);
+            batch->failedCount++;
+            rUnlockExportBatch(batch);
+        }
+    }
+#if defined(RAYTEX_STATS) && defined(RAYTEX_THREADS)
+    threadStats = previousStats;
+    rLockExportBatch(batch);
+    rAddStats((previousStats != NULL) ? previousStats : &stats, &workerStats);
+    rUnlockExportBatch(batch);
+#endif
+    return 0;
+}
+
+bool ExportRayTeXBatch(Font font, RayTeX *texs, const char **fileNames, int count, int fontSize, Color color)
+{
+    // Layout updates the trees' caches, so it stays on this thread - rendering after it only reads them
+    for (int i = 0; i < count; ++i)
+    {
+        rLayoutRayTeXTree(&font, &texs[i], (float)fontSize, false);
+    }
+
+    rExportBatch batch = { 0 };
+    batch.font = &font;
+    batch.texs = texs;
+    batch.fileNames = fileNames;
+    batch.count = count;
+    batch.fontSize = (float)fontSize;
+    batch.color = color;
+
+    int threadCount = rGetProcessorCount();
+    if (threadCount > count) threadCount = count;
+#if defined(RAYTEX_THREADS)
+    if ((threadCount > 1) && (mtx_init(&batch.lock, mtx_plain) == thrd_success))
+    {
+        batch.isLocking = true;
+        thrd_t *threads = RL_MALLOC((threadCount - 1)*sizeof(thrd_t));
+        int startedCount = 0;
+        if (threads != NULL)
+        {
+            for (; startedCount < threadCount - 1; ++startedCount)
+            {
+                if (thrd_create(&threads[startedCount], rExportWorker, &batch) != thrd_success) break;
+            }
+        }
+
+        // This thread works too, and finishes the batch alone if no thread could be started
+        rExportWorker(&batch);
+        for (int i = 0; i < startedCount; ++i) thrd_join(threads[i], NULL);
+        RL_FREE(threads);
+        mtx_destroy(&batch.lock);
+    }
+    else
+    {
+        threadCount = 1;
+        rExportWorker(&batch);
+    }
+#else
+    threadCount = 1;
+    rExportWorker(&batch);
+#endif
+
+    TRACELOG(LOG_INFO, "RAYTEX: Exported %i of %i formulas on %i threads", count - batch.failedCount, count, threadCount);
+    return batch.failedCount == 0;
+}
+
+static void rDrawRayTeXCentered(const Font *font, RayTeX *tex, Rectangle rec, float fontSize, Color color)
+{
+    rLayoutRayTeXTree(font, tex, fontSize, false);
+    RayTeXBox box = rGetLayoutBox(tex, fontSize);
+    Vector2 position = { 0 };
+    position.x = rec.x + (rec.width - box.width) / 2.0f;
+    position.y = rec.y + (rec.height - (box.height + box.depth)) / 2.0f;
+    rDrawRayTeX(&raylibDrawSink, font, tex, position, fontSize, &color, NULL);
 }
 
-RayTeX GenRayTeXTextf(const char *fmt, ...)
+void DrawRayTeXCentered(RayTeX tex, int x, int y, int width, int height, int fontSize, Color color)
+{
+    Rectangle rec = { 0 };
+    rec.x = (float)x;
+    rec.y = (float)y;
+    rec.width = (float)width;
+    rec.height = (float)height;
+    DrawRayTeXCenteredRec(tex, rec, fontSize, color);
+}
+
+void DrawRayTeXCenteredRec(RayTeX tex, Rectangle rec, int fontSize, Color color)
+{
+    DrawRayTeXCenteredPro(GetFontDefault(), tex, rec, (float)fontSize, color);
+}
+
+void DrawRayTeXCenteredPro(Font font, RayTeX tex, Rectangle rec, float fontSize, Color color)
+{
+    RAYTEX_STATS_BEGIN("DrawRayTeX");
+    rDrawRayTeXCentered(&font, &tex, rec, fontSize, color);
+    RAYTEX_STATS_END("DrawRayTeX", drawTime);
+}
+
+// Records primitives into a RayTeXCompiled, or only counts them while `compiled` is NULL
+typedef struct rCompileState {
+    rGlyphCache *cache; // Glyph lookups go to the caller's cache, since batches compile on layout workers
+    RayTeXCompiled *compiled;
+    int commandCount;
+    int glyphCount;
+    int fontCount;
+    Font *fonts; // fontCount fonts, in order of first use
+} rCompileState;
+
+// New fonts only turn up while counting, since both passes see the same fonts
+static int rCompiledFontIndex(rCompileState *state, const Font *font)
+{
+    for (int i = 0; i < state->fontCount; ++i)
+    {
+        if (state->fonts[i].glyphs == font->glyphs) return i;
+    }
+
+    Font *fonts = RL_REALLOC(state->fonts, (state->fontCount + 1)*sizeof(Font));
+    if (fonts == NULL)
+    {
+        TRACELOG(LOG_ERROR, "RAYTEX: CompileRayTeX() failed to allocate");
+        return 0;
+    }
+    state->fonts = fonts;
+    state->fonts[state->fontCount] = *font;
+    return state->fontCount++;
+}
+
+static RayTeXCommand *rNextCompiledCommand(rCompileState *state, RayTeXCommandType type, const Font *font, const Color *color)
+{
+    int fontIndex = rCompiledFontIndex(state, font);
+    if (state->compiled == NULL) return NULL;
+
+    RayTeXCommand *command = &state->compiled->commands[state->commandCount];
+    command->type = type;
+    command->isInheritingColor = (color == NULL);
+    if (color != NULL) command->color = *color;
+    command->fontIndex = fontIndex;
+    return command;
+}
+
+static void rCompileGlyph(rCompileState *state, int index, float x)
+{
+    if (state->compiled != NULL)
+    {
+        state->compiled->glyphs[state->glyphCount].index = index;
+        state->compiled->glyphs[state->glyphCount].x = x;
+    }
+    state->glyphCount++;
+}
+
+// Glyphs are placed as rDrawTextSlice() places them, so that replaying the run draws the same quads
+static void rCompileText(void *userData, const Font *font, const char *text, int length, Vector2 position, float fontSize, const Color *color)
+{
+    rCompileState *state = userData;
+    if (length == 0) length = (int)strlen(text);
+    RayTeXCommand *command = rNextCompiledCommand(state, TEXCOMMAND_TEXT, font, color);
+    if (command != NULL)
+    {
+        command->text.y = position.y;
+        command->text.fontSize = fontSize;
+        command->text.glyphStart = state->glyphCount;
+    }
+
+    rFontGlyphs *glyphs = rGetCachedFontGlyphs(state->cache, *font);
+    float scaleFactor = fontSize / (float)font->baseSize;
+    float textOffsetX = 0.0f;
+    for (int i = 0; i < length;)
+    {
+        int codepointByteCount = 0;
+        int codepoint = GetCodepointNext(&text[i], &codepointByteCount);
+        int index = rGetGlyphIndex(*font, glyphs, codepoint);
+        if ((codepoint != ' ') && (codepoint != '\t')) rCompileGlyph(state, index, position.x + textOffsetX);
+        textOffsetX += rGlyphDrawAdvance(*font, index)*scaleFactor + fontSize / 10;
+        i += codepointByteCount;
+    }
+
+    if (command != NULL) command->text.glyphCount = state->glyphCount - command->text.glyphStart;
+    state->commandCount++;
+}
+
+// Shaped text is copied as it is, placed as rRaylibDrawGlyphRun() places it
+static void rCompileGlyphRun(void *userData, const Font *font, const int *glyphIndices, const float *glyphOffsets, int glyphCount, Vector2 position, float fontSize, const Color *color)
+{
+    rCompileState *state = userData;
+    RayTeXCommand *command = rNextCompiledCommand(state, TEXCOMMAND_TEXT, font, color);
+    if (command != NULL)
+    {
+        command->text.y = position.y;
+        command->text.fontSize = fontSize;
+        command->text.glyphStart = state->glyphCount;
+    }
+
+    float scaleFactor = fontSize / (float)font->baseSize;
+    float spacing = fontSize / 10;
+    for (int i = 0; i < glyphCount; ++i)
+    {
+        if (glyphIndices[i] >= 0) rCompileGlyph(state, glyphIndices[i], position.x + glyphOffsets[i]*scaleFactor + (float)i*spacing);
+    }
+
+    if (command != NULL) command->text.glyphCount = state->glyphCount - command->text.glyphStart;
+    state->commandCount++;
+}
+
+static void rCompileRule(void *userData, const Font *font, Rectangle rec, const Color *color)
+{
+    rCompileState *state = userData;
+    RayTeXCommand *command = rNextCompiledCommand(state, TEXCOMMAND_RULE, font, color);
+    if (command != NULL) command->rule.rec = rec;
+    state->commandCount++;
+}
+
+static void rCompileLine(void *userData, const Font *font, Vector2 startPos, Vector2 endPos, const Color *color)
+{
+    rCompileState *state = userData;
+    RayTeXCommand *command = rNextCompiledCommand(state, TEXCOMMAND_LINE, font, color);
+    if (command != NULL)
+    {
+        command->line.startPos = startPos;
+        command->line.endPos = endPos;
+    }
+    state->commandCount++;
+}
+
+// Records an element that has already been laid out, looking glyphs up in the given cache
+static RayTeXCompiled rCompileRayTeX(rGlyphCache *cache, const Font *font, const RayTeX *tex, float fontSize)
+{
+    RayTeXCompiled compiled = { 0 };
+    compiled.box = rGetLayoutBox(tex, fontSize);
+
+    // First pass counts, second pass records into a single allocation - fonts first, since they hold pointers
+    rCompileState state = { 0 };
+    state.cache = cache;
+    rDrawSink sink = { &state, rCompileText, rCompileGlyphRun, rCompileRule, rCompileLine };
+    Vector2 origin = { 0 };
+    rDrawRayTeX(&sink, font, tex, origin, fontSize, NULL, NULL);
+
+    compiled.fonts = RL_MALLOC(state.fontCount*sizeof(Font) + state.commandCount*sizeof(RayTeXCommand) + state.glyphCount*sizeof(RayTeXCompiledGlyph));
+    if (compiled.fonts != NULL)
+    {
+        compiled.fontCount = state.fontCount;
+        compiled.commands = (RayTeXCommand *)(compiled.fonts + state.fontCount);
+        compiled.commandCount = state.commandCount;
+        compiled.glyphs = (RayTeXCompiledGlyph *)(compiled.commands + state.commandCount);
+        compiled.glyphCount = state.glyphCount;
+        if (state.fontCount > 0) memcpy(compiled.fonts, state.fonts, state.fontCount*sizeof(Font));
+
+        state.compiled = &compiled;
+        state.commandCount = 0;
+        state.glyphCount = 0;
+        rDrawRayTeX(&sink, font, tex, origin, fontSize, NULL, NULL);
+    }
+    else TRACELOG(LOG_ERROR, "RAYTEX: CompileRayTeX() failed to allocate");
+    RL_FREE(state.fonts);
+    return compiled;
+}
+
+RayTeXCompiled CompileRayTeX(Font font, RayTeX tex, int fontSize)
+{
+    rLayoutRayTeXTree(&font, &tex, (float)fontSize, false);
+    RayTeXCompiled compiled = rCompileRayTeX(&glyphCache, &font, &tex, (float)fontSize);
+    if (compiled.commands != NULL) TRACELOG(LOG_INFO, "RAYTEX: TeX compiled into %i commands successfully", compiled.commandCount);
+    return compiled;
+}
+
+void UnloadRayTeXCompiled(RayTeXCompiled compiled)
+{
+    RL_FREE(compiled.fonts);
+    TRACELOG(LOG_INFO, "RAYTEX: Compiled TeX unloaded successfully");
+}
+
+void DrawRayTeXCompiled(RayTeXCompiled compiled, int x, int y, Color color)
+{
+    Vector2 offset = { 0 };
+    offset.x = (float)x;
+    offset.y = (float)y;
+    for (int i = 0; i < compiled.commandCount; ++i)
+    {
+        const RayTeXCommand *command = &compiled.commands[i];
+        const Font *font = &compiled.fonts[command->fontIndex];
+        Color commandColor = command->isInheritingColor ? color : command->color;
+        switch (command->type)
+        {
+        case TEXCOMMAND_TEXT:
+        {
+            RAYTEX_STATS_ADD(drawTextCount, 1);
+            const RayTeXCompiledGlyph *glyphs = &compiled.glyphs[command->text.glyphStart];
+            for (int k = 0; k < command->text.glyphCount; ++k)
+            {
+                Vector2 position = { offset.x + glyphs[k].x, offset.y + command->text.y };
+                rDrawGlyph(*font, glyphs[k].index, position, command->text.fontSize, commandColor);
+            }
+        }
+            break;
+
+        case TEXCOMMAND_RULE:
+        {
+            Rectangle rec = command->rule.rec;
+            rec.x += offset.x;
+            rec.y += offset.y;
+            raylibDrawSink.DrawRule(NULL, font, rec, &commandColor);
+        }
+            break;
+
+        case TEXCOMMAND_LINE:
+        {
+            Vector2 startPos = { offset.x + command->line.startPos.x, offset.y + command->line.startPos.y };
+            Vector2 endPos = { offset.x + command->line.endPos.x, offset.y + command->line.endPos.y };
+            raylibDrawSink.DrawLine(NULL, font, startPos, endPos, &commandColor);
+        }
+            break;
+
+        default: TRACELOG(LOG_WARNING, "RAYTEX: Unknown compiled command [%i]", command->type);
+        }
+    }
+}
+
+typedef struct rLayoutBatch {
+    Font font;
+    RayTeX **texs;
+    float fontSize;
+    RayTeXBox *boxes;
+    RayTeXCompiled *compiled;
+} rLayoutBatch;
+
+static bool rLayoutBatchItem(rGlyphCache *cache, void *userData, int index)
+{
+    rLayoutBatch *batch = userData;
+
+    // The root keeps its layout, so the next batch only lays out what was edited since
+    RayTeX *tex = batch->texs[index];
+    bool isChanged = rLayoutRayTeXRoot(cache, &batch->font, tex, batch->fontSize, true);
+    if (batch->boxes != NULL) batch->boxes[index] = rGetLayoutBox(tex, batch->fontSize);
+    if (batch->compiled != NULL) batch->compiled[index] = rCompileRayTeX(cache, &batch->font, tex, batch->fontSize);
+    return isChanged;
+}
+
+void LayoutRayTeXBatch(RayTeX **texs, int count, Font font, int fontSize, RayTeXBox *boxes, RayTeXCompiled *compiled)
+{
+    rLayoutBatch batch = { font, texs, (float)fontSize, boxes, compiled };
+    bool isLaidOut = false;
+#if defined(RAYTEX_THREADS)
+    // Small batches are not worth starting threads for, and formulas with shared elements could reach them from
+    // two threads at once, so both fall through to the loop below
+    bool isSharing = false;
+    for (int i = 0; i < count; ++i)
+    {
+        if (texs[i]->isSharing) isSharing = true;
+    }
+    bool isChanged = false;
+    isLaidOut = !isSharing && rRunLayoutPool(count, rLayoutBatchItem, &batch, &isChanged);
+#endif
+    if (!isLaidOut)
+    {
+        for (int i = 0; i < count; ++i) rLayoutBatchItem(&glyphCache, &batch, i);
+    }
+
+    // Workers only lay out their own roots, so what the roots' children are linked to is marked here
+    for (int i = 0; i < count; ++i) rMarkRayTeXOwnerChanged(texs[i]);
+}
+
+#define MAX_TEMPLATE_SLOT_NAME_LENGTH 32
+
+struct RayTeXTemplateSlot {
+    char name[MAX_TEMPLATE_SLOT_NAME_LENGTH];
+    RayTeX **path;         // depth elements from below the root down to the slot's text element
+    int depth;             // 0 if the slot is the root itself
+};
+
+// Element at the given level of a slot's path, where level 0 is the root
+static RayTeX *rGetTemplateElement(RayTeXTemplate *tmpl, const struct RayTeXTemplateSlot *slot, int level)
+{
+    return (level == 0) ? &tmpl->tex : slot->path[level - 1];
+}
+
+// Counts the slots below the element, and fills them in when slots is not NULL
+static int rFindTemplateSlots(RayTeX *tex, RayTeX **path, int depth, struct RayTeXTemplateSlot *slots)
+{
+    if ((tex->mode == TEXMODE_TEXT) && tex->isSlot)
+    {
+        if (slots == NULL) return 1;
+        slots->path = (depth > 0) ? RL_MALLOC(depth*sizeof(RayTeX *)) : NULL;
+        if (depth > 0)
+        {
+            if (slots->path == NULL) return 0;
+            memcpy(slots->path, path, depth*sizeof(RayTeX *));
+        }
+        slots->depth = depth;
+        int length = rTextLength(tex);
+        if (length >= MAX_TEMPLATE_SLOT_NAME_LENGTH) length = MAX_TEMPLATE_SLOT_NAME_LENGTH - 1;
+        memcpy(slots->name, rTextContent(tex), length);
+        slots->name[length] = '\0';
+        return 1;
+    }
+
+    int childCount = 0;
+    Vector2 *offsets = NULL;
+    RayTeXRef *children = rGetRayTeXChildren(tex, &childCount, &offsets);
+    int count = 0;
+    for (int i = 0; i < childCount; ++i)
+    {
+        path[depth] = children[i].ptr;
+        count += rFindTemplateSlots(children[i].ptr, path, depth + 1, (slots != NULL) ? slots + count : NULL);
+    }
+    return count;
+}
+
+static int rGetTemplateDepth(const RayTeX *tex)
+{
+    int childCount = 0;
+    Vector2 *offsets = NULL;
+    RayTeXRef *children = rGetRayTeXChildren(tex, &childCount, &offsets);
+    int depth = 0;
+    for (int i = 0; i < childCount; ++i)
+    {
+        int childDepth = rGetTemplateDepth(children[i].ptr) + 1;
+        if (childDepth > depth) depth = childDepth;
+    }
+    return depth;
+}
+
+RayTeXTemplate LoadRayTeXTemplate(const char *source)
+{
+    RayTeXTemplate tmpl = { 0 };
+
+    // Slots have to stay separate elements, so nothing is interned
+    RayTeXInterner *interner = currentInterner;
+    currentInterner = NULL;
+    tmpl.tex = ParseRayTeX(source);
+    currentInterner = interner;
+
+    RayTeX **path = RL_MALLOC((rGetTemplateDepth(&tmpl.tex) + 1)*sizeof(RayTeX *));
+    int slotCount = (path != NULL) ? rFindTemplateSlots(&tmpl.tex, path, 0, NULL) : 0;
+    if (slotCount > 0) tmpl.slots = RL_CALLOC(slotCount, sizeof(struct RayTeXTemplateSlot));
+    if (tmpl.slots != NULL) tmpl.slotCount = rFindTemplateSlots(&tmpl.tex, path, 0, tmpl.slots);
+    else if (slotCount > 0) TRACELOG(LOG_ERROR, "RAYTEX: LoadRayTeXTemplate() failed to allocate");
+    RL_FREE(path);
+
+    TRACELOG(LOG_DEBUG, "RAYTEX: TeX template with %i slots loaded successfully", tmpl.slotCount);
+    return tmpl;
+}
+
+void UnloadRayTeXTemplate(RayTeXTemplate tmpl)
+{
+    for (int i = 0; i < tmpl.slotCount; ++i) RL_FREE(tmpl.slots[i].path);
+    RL_FREE(tmpl.slots);
+    UnloadRayTeX(tmpl.tex);
+}
+
+int GetRayTeXTemplateSlot(RayTeXTemplate tmpl, const char *name)
+{
+    for (int i = 0; i < tmpl.slotCount; ++i)
+    {
+        if (strcmp(tmpl.slots[i].name, name) == 0) return i;
+    }
+    TRACELOG(LOG_WARNING, "RAYTEX: Template has no slot \"%s\"", name);
+    return -1;
+}
+
+static void rSetRayTeXTemplateSlotV(RayTeXTemplate *tmpl, int slot, const char *fmt, va_list args)
+{
+    if ((slot < 0) || (slot >= tmpl->slotCount)) return;
+    struct RayTeXTemplateSlot *templateSlot = &tmpl->slots[slot];
+    RayTeX *element = rGetTemplateElement(tmpl, templateSlot, templateSlot->depth);
+
+    // The element formats into its own storage, which only grows, so setting values of similar length every frame does not allocate.
+    // It marks the elements above it, so only the slot's path is laid out again.
+    rUpdateRayTeXTextV(element, fmt, args);
+}
+
+void SetRayTeXTemplateSlot(RayTeXTemplate *tmpl, int slot, const char *text)
+{
+    if ((slot < 0) || (slot >= tmpl->slotCount)) return;
+    struct RayTeXTemplateSlot *templateSlot = &tmpl->slots[slot];
+    const RayTeX *element = rGetTemplateElement(tmpl, templateSlot, templateSlot->depth);
+
+    // Until it is first set, the element still holds the slot's name from the source
+    bool isSet = element->text.isInline || element->text.isOwned;
+    if (isSet && (strcmp(rTextContent(element), text) == 0)) return;
+    SetRayTeXTemplateSlotf(tmpl, slot, "%s", text);
+}
+
+void SetRayTeXTemplateSlotf(RayTeXTemplate *tmpl, int slot, const char *fmt, ...)
 {
-    char buffer[MAX_TEXT_BUFFER_LENGTH];
     va_list args;
     va_start(args, fmt);
-    vsprintf_s(buffer, MAX_TEXT_BUFFER_LENGTH, fmt, args);
+    rSetRayTeXTemplateSlotV(tmpl, slot, fmt, args);
     va_end(args);
-    size_t sizeUsed = sizeof(char) * (strlen(buffer) + 1);
-    char *memory = RL_MALLOC(sizeUsed);
-    if (memory != NULL)
+}
+
+RayTeXBox MeasureRayTeXTemplate(Font font, RayTeXTemplate *tmpl, int fontSize)
+{
+    RAYTEX_STATS_BEGIN("MeasureRayTeX");
+    rLayoutRayTeXTree(&font, &tmpl->tex, (float)fontSize, true);
+    RAYTEX_STATS_END("MeasureRayTeX", measureTime);
+    return rGetLayoutBox(&tmpl->tex, (float)fontSize);
+}
+
+void DrawRayTeXTemplate(Font font, RayTeXTemplate *tmpl, int x, int y, int fontSize, Color color)
+{
+    Vector2 position = { 0 };
+    position.x = (float)x;
+    position.y = (float)y;
+    RAYTEX_STATS_BEGIN("DrawRayTeX");
+    rLayoutRayTeXTree(&font, &tmpl->tex, (float)fontSize, true);
+    rDrawRayTeX(&raylibDrawSink, &font, &tmpl->tex, position, (float)fontSize, &color, NULL);
+    RAYTEX_STATS_END("DrawRayTeX", drawTime);
+}
+
+// Binary layout of a RayTeXBlob - every reference is a byte offset from the start of the blob, so it can be mapped anywhere
+// Native byte order, 4-byte aligned. Bump the version whenever any of these structs change.
+#define RAYTEX_BLOB_VERSION 1
+
+typedef struct rBlobHeader {
+    char magic[4];           // "RTXB"
+    unsigned int version;
+    unsigned int size;       // Size of the whole blob in bytes
+    RayTeXBox box;
+    unsigned int fontCount;
+    unsigned int commandCount;
+    unsigned int glyphCount;
+    unsigned int fontsOffset;
+    unsigned int commandsOffset;
+    unsigned int glyphsOffset;
+} rBlobHeader;
+
+// What the font used when exporting looked like, to tell whether the stored glyph indices still apply
+typedef struct rBlobFont {
+    int baseSize;
+    int glyphCount;
+} rBlobFont;
+
+typedef struct rBlobCommand {
+    unsigned char type;              // RayTeXCommandType - TEXCOMMAND_TEXT is a glyph run
+    unsigned char isInheritingColor;
+    unsigned short fontIndex;
+    Color color;
+    float fontSize;
+    float data[4];                   // Glyph run: y in data[1]. Rule: x, y, width, height. Line: start x, start y, end x, end y.
+    unsigned int glyphStart;
+    unsigned int glyphCount;
+} rBlobCommand;
+
+typedef struct rBlobGlyph {
+    int codepoint; // Kept so that a different font can still look the glyph up
+    int index;
+    float x;       // Relative to the formula, with scaling and spacing applied
+} rBlobGlyph;
+
+enum {
+    RAYTEX_BLOB_BORROWED = 0,
+    RAYTEX_BLOB_LOADED   = 1, // Loaded with LoadFileData()
+    RAYTEX_BLOB_MAPPED   = 2,
+};
+
+// Records primitives into a blob, or only counts them while `data` is NULL
+typedef struct rBlobState {
+    unsigned char *data;
+    int commandCount;
+    int glyphCount;
+    int fontCount;
+    const GlyphInfo **fontIds; // fontCount fonts, in order of first use
+    rBlobFont *fonts;
+} rBlobState;
+
+static int rBlobFontIndex(rBlobState *state, const Font *font)
+{
+    for (int i = 0; i < state->fontCount; ++i)
     {
-        memcpy(memory, buffer, sizeUsed);
-        RayTeX element = { 0 };
-        element.mode = TEXMODE_TEXT;
-        element.text.isOwned = true;
-        element.text.content = memory;
-        TRACELOG(LOG_INFO, "RAYTEX: TeX text element \"%s\" generated successfully", buffer);
-        return element;
+        if (state->fontIds[i] == font->glyphs) return i;
     }
-    else TRACELOG(LOG_ERROR, "GenRayTeXTextf() failed to allocate");
+
+    // New fonts only turn up while counting, since both passes see the same fonts
+    const GlyphInfo **fontIds = RL_REALLOC(state->fontIds, (state->fontCount + 1)*sizeof(const GlyphInfo *));
+    rBlobFont *fonts = (fontIds != NULL) ? RL_REALLOC(state->fonts, (state->fontCount + 1)*sizeof(rBlobFont)) : NULL;
+    if (fontIds != NULL) state->fontIds = fontIds;
+    if (fonts == NULL)
+    {
+        TRACELOG(LOG_ERROR, "RAYTEX: ExportRayTeXBlob() failed to allocate");
+        return 0;
+    }
+    state->fonts = fonts;
+    state->fontIds[state->fontCount] = font->glyphs;
+    state->fonts[state->fontCount].baseSize = font->baseSize;
+    state->fonts[state->fontCount].glyphCount = font->glyphCount;
+    return state->fontCount++;
 }
 
-RayTeX GenRayTeXSymbol(RayTeXSymbol symbol)
+static rBlobCommand *rNextBlobCommand(rBlobState *state, RayTeXCommandType type, const Font *font, float fontSize, const Color *color)
 {
-    RayTeX element = { 0 };
-    element.mode = TEXMODE_SYMBOL;
-    element.symbol.content = symbol;
-    TRACELOG(LOG_INFO, "RAYTEX: TeX symbol element generated successfully");
-    return element;
+    int fontIndex = rBlobFontIndex(state, font);
+    if (state->data == NULL) return NULL;
+
+    const rBlobHeader *header = (const rBlobHeader *)state->data;
+    rBlobCommand *command = (rBlobCommand *)(state->data + header->commandsOffset) + state->commandCount;
+    memset(command, 0, sizeof(rBlobCommand));
+    command->type = (unsigned char)type;
+    command->isInheritingColor = (color == NULL);
+    if (color != NULL) command->color = *color;
+    command->fontIndex = (unsigned short)fontIndex;
+    command->fontSize = fontSize;
+    return command;
 }
 
-static RayTeXRef RayTeXRefFromValue(RayTeX value)
+// Text is shaped here even when the element has a glyph run, since the blob also keeps the codepoints
+static void rBlobText(void *userData, const Font *font, const char *text, int length, Vector2 position, float fontSize, const Color *color)
 {
-    RayTeX *pointer = RL_MALLOC(sizeof(RayTeX));
-    if (pointer != NULL)
+    rBlobState *state = userData;
+    if (length == 0) length = (int)strlen(text);
+    rFontGlyphs *glyphs = rGetFontGlyphs(*font);
+    rBlobCommand *command = rNextBlobCommand(state, TEXCOMMAND_TEXT, font, fontSize, color);
+    rBlobGlyph *blobGlyphs = (state->data != NULL) ? (rBlobGlyph *)(state->data + ((const rBlobHeader *)state->data)->glyphsOffset) : NULL;
+    if (command != NULL)
     {
-        *pointer = value;
-        RayTeXRef ref = { 0 };
-        ref.isOwned = true;
-        ref.ptr = pointer;
-        return ref;
+        command->data[0] = position.x;
+        command->data[1] = position.y;
+        command->glyphStart = (unsigned int)state->glyphCount;
     }
-    else TRACELOG(LOG_ERROR, "RayTeXRefFromValue() failed to allocate");
+
+    float scaleFactor = fontSize / (float)font->baseSize;
+    float textOffsetX = 0.0f;
+    for (int i = 0; i < length;)
+    {
+        int codepointByteCount = 0;
+        int codepoint = GetCodepointNext(&text[i], &codepointByteCount);
+        int index = rGetGlyphIndex(*font, glyphs, codepoint);
+        if ((codepoint != ' ') && (codepoint != '\t'))
+        {
+            if (blobGlyphs != NULL)
+            {
+                blobGlyphs[state->glyphCount].codepoint = codepoint;
+                blobGlyphs[state->glyphCount].index = index;
+                blobGlyphs[state->glyphCount].x = position.x + textOffsetX;
+            }
+            state->glyphCount++;
+        }
+        textOffsetX += rGlyphDrawAdvance(*font, index)*scaleFactor + fontSize / 10;
+        i += codepointByteCount;
+    }
+
+    if (command != NULL) command->glyphCount = (unsigned int)state->glyphCount - command->glyphStart;
+    state->commandCount++;
 }
 
-static RayTeXRef RayTeXRefFromPointer(RayTeX *pointer)
+static void rBlobRule(void *userData, const Font *font, Rectangle rec, const Color *color)
 {
-    RayTeXRef ref = { 0 };
-    ref.isOwned = false;
-    ref.ptr = pointer;
-    return ref;
+    rBlobState *state = userData;
+    rBlobCommand *command = rNextBlobCommand(state, TEXCOMMAND_RULE, font, 0.0f, color);
+    if (command != NULL)
+    {
+        command->data[0] = rec.x;
+        command->data[1] = rec.y;
+        command->data[2] = rec.width;
+        command->data[3] = rec.height;
+    }
+    state->commandCount++;
 }
 
-RayTeX GenRayTeXFrac(char fmt0, char fmt1, ...)
+static void rBlobLine(void *userData, const Font *font, Vector2 startPos, Vector2 endPos, const Color *color)
 {
-    RayTeX element = { 0 };
-    element.mode = TEXMODE_FRAC;
-    va_list args;
-    va_start(args, fmt1);
-    for (int i = 0; i < 2; ++i)
+    rBlobState *state = userData;
+    rBlobCommand *command = rNextBlobCommand(state, TEXCOMMAND_LINE, font, 0.0f, color);
+    if (command != NULL)
     {
-        char ch = i == 0 ? fmt0 : fmt1;
-        switch (ch)
-        {
-            case ' ': element.frac.content[i] = RayTeXRefFromValue(GenRayTeXSpace(va_arg(args, int)));           break;
-            case 't': element.frac.content[i] = RayTeXRefFromValue(GenRayTeXText(va_arg(args, const char*)));    break;
-            case 's': element.frac.content[i] = RayTeXRefFromValue(GenRayTeXSymbol(va_arg(args, RayTeXSymbol))); break;
-            case 'i': element.frac.content[i] = RayTeXRefFromValue(GenRayTeXTextf("%i", va_arg(args, int)));     break;
-            case 'v': element.frac.content[i] = RayTeXRefFromValue(va_arg(args, RayTeX));                        break;
-            case 'p': element.frac.content[i] = RayTeXRefFromPointer(va_arg(args, RayTeX*));                     break;
+        command->data[0] = startPos.x;
+        command->data[1] = startPos.y;
+        command->data[2] = endPos.x;
+        command->data[3] = endPos.y;
+    }
+    state->commandCount++;
+}
 
-            default: TRACELOG(LOG_WARNING, "RAYTEX: GenRayTeXFrac() at index %i of fmt '%c','%c': meaning of '%c' is unknown", i, fmt0, fmt1, ch);
+unsigned char *ExportRayTeXBlobToMemory(Font font, RayTeX tex, int fontSize, int *dataSize)
+{
+    *dataSize = 0;
+    rLayoutRayTeXTree(&font, &tex, (float)fontSize, false);
+
+    // First pass counts, second pass writes into a single allocation, like CompileRayTeX()
+    rBlobState state = { 0 };
+    rDrawSink sink = { &state, rBlobText, NULL, rBlobRule, rBlobLine };
+    Vector2 origin = { 0 };
+    rDrawRayTeX(&sink, &font, &tex, origin, (float)fontSize, NULL, NULL);
+
+    rBlobHeader header = { { 'R', 'T', 'X', 'B' }, RAYTEX_BLOB_VERSION };
+    header.box = rGetLayoutBox(&tex, (float)fontSize);
+    header.fontCount = (unsigned int)state.fontCount;
+    header.commandCount = (unsigned int)state.commandCount;
+    header.glyphCount = (unsigned int)state.glyphCount;
+    header.fontsOffset = sizeof(rBlobHeader);
+    header.commandsOffset = header.fontsOffset + header.fontCount*sizeof(rBlobFont);
+    header.glyphsOffset = header.commandsOffset + header.commandCount*sizeof(rBlobCommand);
+    header.size = header.glyphsOffset + header.glyphCount*sizeof(rBlobGlyph);
+
+    unsigned char *data = RL_CALLOC(header.size, 1);
+    if (data != NULL)
+    {
+        memcpy(data, &header, sizeof(rBlobHeader));
+        if (state.fontCount > 0) memcpy(data + header.fontsOffset, state.fonts, header.fontCount*sizeof(rBlobFont));
+
+        state.data = data;
+        state.commandCount = 0;
+        state.glyphCount = 0;
+        rDrawRayTeX(&sink, &font, &tex, origin, (float)fontSize, NULL, NULL);
+        *dataSize = (int)header.size;
+    }
+    else TRACELOG(LOG_ERROR, "RAYTEX: ExportRayTeXBlobToMemory() failed to allocate");
+
+    RL_FREE(state.fontIds);
+    RL_FREE(state.fonts);
+    return data;
+}
+
+bool ExportRayTeXBlob(Font font, RayTeX tex, int fontSize, const char *fileName)
+{
+    int dataSize = 0;
+    unsigned char *data = ExportRayTeXBlobToMemory(font, tex, fontSize, &dataSize);
+    bool isSaved = (data != NULL) && SaveFileData(fileName, data, dataSize);
+    RL_FREE(data);
+    if (isSaved) TRACELOG(LOG_INFO, "RAYTEX: [%s] TeX blob exported successfully (%i bytes)", fileName, dataSize);
+    else TRACELOG(LOG_WARNING, "RAYTEX: [%s] Failed to export TeX blob", fileName);
+    return isSaved;
+}
+
+// Checks every offset and count once, so that drawing can trust them
+static bool rIsRayTeXBlobValid(const unsigned char *data, int dataSize)
+{
+    if ((data == NULL) || (dataSize < (int)sizeof(rBlobHeader))) return false;
+
+    const rBlobHeader *header = (const rBlobHeader *)data;
+    if (memcmp(header->magic, "RTXB", 4) != 0) return false;
+    if (header->version != RAYTEX_BLOB_VERSION)
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: TeX blob version %u is not supported (expected %u)", header->version, RAYTEX_BLOB_VERSION);
+        return false;
+    }
+    if ((header->size > (unsigned int)dataSize) || (header->fontsOffset < sizeof(rBlobHeader)) ||
+        (header->fontsOffset + (unsigned long long)header->fontCount*sizeof(rBlobFont) > header->commandsOffset) ||
+        (header->commandsOffset + (unsigned long long)header->commandCount*sizeof(rBlobCommand) > header->glyphsOffset) ||
+        (header->glyphsOffset + (unsigned long long)header->glyphCount*sizeof(rBlobGlyph) > header->size) ||
+        ((header->fontsOffset % 4) != 0) || ((header->commandsOffset % 4) != 0) || ((header->glyphsOffset % 4) != 0)) return false;
+
+    // Glyph indices are drawn as they are with a font like the one exported with, so they must be in its range
+    const rBlobFont *fonts = (const rBlobFont *)(data + header->fontsOffset);
+    const rBlobCommand *commands = (const rBlobCommand *)(data + header->commandsOffset);
+    const rBlobGlyph *glyphs = (const rBlobGlyph *)(data + header->glyphsOffset);
+    for (unsigned int i = 0; i < header->commandCount; ++i)
+    {
+        if (((commands[i].type != TEXCOMMAND_TEXT) && (commands[i].type != TEXCOMMAND_RULE) && (commands[i].type != TEXCOMMAND_LINE)) ||
+            (commands[i].fontIndex >= header->fontCount) ||
+            ((unsigned long long)commands[i].glyphStart + commands[i].glyphCount > header->glyphCount)) return false;
+
+        if (commands[i].type != TEXCOMMAND_TEXT) continue;
+        for (unsigned int k = commands[i].glyphStart; k < commands[i].glyphStart + commands[i].glyphCount; ++k)
+        {
+            if ((glyphs[k].index < 0) || (glyphs[k].index >= fonts[commands[i].fontIndex].glyphCount)) return false;
         }
     }
-    va_end(args);
-    TRACELOG(LOG_INFO, "RAYTEX: TeX fraction element generated successfully");
-    return element;
+    return true;
+}
+
+RayTeXBlob LoadRayTeXBlobFromMemory(const unsigned char *data, int dataSize)
+{
+    RayTeXBlob blob = { 0 };
+    if (!rIsRayTeXBlobValid(data, dataSize))
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: Invalid TeX blob");
+        return blob;
+    }
+    blob.data = data;
+    blob.dataSize = dataSize;
+    blob.storage = RAYTEX_BLOB_BORROWED;
+    return blob;
 }
 
-RayTeX GenRayTeXHorizontal(const char *fmt, ...)
+RayTeXBlob LoadRayTeXBlob(const char *fileName)
 {
-    int count = (int)strlen(fmt);
-    RayTeX element = { 0 };
-    element.mode = TEXMODE_HORIZONTAL;
-    element.horizontal.elementCount = count;
-    element.horizontal.content = RL_MALLOC(count * sizeof(RayTeXRef));
-    if (element.horizontal.content != NULL)
+    RayTeXBlob blob = { 0 };
+    unsigned char *data = NULL;
+    int dataSize = 0;
+    int storage = RAYTEX_BLOB_MAPPED;
+
+    // Map the file read-only, so that pages are only read in as they are drawn
+#if defined(_WIN32)
+    void *file = CreateFileA(fileName, 0x80000000 /* GENERIC_READ */, 0x1 /* FILE_SHARE_READ */, NULL, 3 /* OPEN_EXISTING */, 0x80 /* FILE_ATTRIBUTE_NORMAL */, NULL);
+    if (file != (void *)(long long)-1)
     {
-        int argC = 0;
-        va_list args;
-        va_start(args, fmt);
-        for (int i = 0; i < count; ++i)
+        long long fileSize = 0;
+        if (GetFileSizeEx(file, &fileSize) && (fileSize > 0) && (fileSize <= 0x7FFFFFFF))
         {
-            switch (fmt[i])
+            void *mapping = CreateFileMappingA(file, NULL, 0x02 /* PAGE_READONLY */, 0, 0, NULL);
+            if (mapping != NULL)
             {
-            case ' ': element.horizontal.content[i] = RayTeXRefFromValue(GenRayTeXSpace(va_arg(args, int)));           break;
-            case 't': element.horizontal.content[i] = RayTeXRefFromValue(GenRayTeXText(va_arg(args, const char*)));    break;
-            case 's': element.horizontal.content[i] = RayTeXRefFromValue(GenRayTeXSymbol(va_arg(args, RayTeXSymbol))); break;
-            case 'i': element.horizontal.content[i] = RayTeXRefFromValue(GenRayTeXTextf("%i", va_arg(args, int)));     break;
-            case 'v': element.horizontal.content[i] = RayTeXRefFromValue(va_arg(args, RayTeX));                        break;
-            case 'p': element.horizontal.content[i] = RayTeXRefFromPointer(va_arg(args, RayTeX*));                     break;
-
-            default: TRACELOG(LOG_WARNING, "RAYTEX: GenRayTeXHorizontal() at index %i of fmt \"%s\": meaning of '%c' is unknown", i, fmt, fmt[i]);
+                // The view keeps the mapping alive after its handle is closed
+                data = MapViewOfFile(mapping, 0x4 /* FILE_MAP_READ */, 0, 0, 0);
+                dataSize = (int)fileSize;
+                CloseHandle(mapping);
             }
         }
-        va_end(args);
-        TRACELOG(LOG_INFO, "RAYTEX: TeX horizontal with %i elements generated successfully", count);
+        CloseHandle(file);
     }
-    else TRACELOG(LOG_ERROR, "RAYTEX: GenRayTeXHorizontal() failed to allocate");
-    return element;
-}
-
-// WARNING: Shallow copies of the elements are created.
-// Unloading them outside of the vertical will also unload them for the vertical,
-// and unloading the vertical will also unload them outside of the vertical.
-RayTeX GenRayTeXVertical(const char *fmt, ...)
-{
-    int count = (int)strlen(fmt);
-    RayTeX element = { 0 };
-    element.mode = TEXMODE_VERTICAL;
-    element.vertical.elementCount = count;
-    element.vertical.content = RL_MALLOC(count * sizeof(RayTeXRef));
-    if (element.vertical.content != NULL)
+#else
+    int file = open(fileName, O_RDONLY);
+    if (file >= 0)
     {
-        va_list args;
-        va_start(args, fmt);
-        for (int i = 0; i < count; ++i)
+        struct stat fileStat;
+        if ((fstat(file, &fileStat) == 0) && (fileStat.st_size > 0) && (fileStat.st_size <= 0x7FFFFFFF))
         {
-            switch (fmt[i])
+            void *mapping = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (mapping != MAP_FAILED)
             {
-            case ' ': element.vertical.content[i] = RayTeXRefFromValue(GenRayTeXSpace(va_arg(args, int)));           break;
-            case 't': element.vertical.content[i] = RayTeXRefFromValue(GenRayTeXText(va_arg(args, const char*)));    break;
-            case 's': element.vertical.content[i] = RayTeXRefFromValue(GenRayTeXSymbol(va_arg(args, RayTeXSymbol))); break;
-            case 'i': element.vertical.content[i] = RayTeXRefFromValue(GenRayTeXTextf("%i", va_arg(args, int)));     break;
-            case 'v': element.vertical.content[i] = RayTeXRefFromValue(va_arg(args, RayTeX));                        break;
-            case 'p': element.vertical.content[i] = RayTeXRefFromPointer(va_arg(args, RayTeX*));                     break;
-
-            default: TRACELOG(LOG_WARNING, "RAYTEX: GenRayTeXVertical() at index %i of fmt \"%s\": meaning of '%c' is unknown", i, fmt, fmt[i]);
+                data = mapping;
+                dataSize = (int)fileStat.st_size;
             }
         }
-        va_end(args);
-        TRACELOG(LOG_INFO, "RAYTEX: TeX vertical with %i elements generated successfully", count);
+        close(file);
     }
-    else TRACELOG(LOG_ERROR, "RAYTEX: GenRayTeXVertical() failed to allocate");
-    return element;
+#endif
+
+    if (data == NULL)
+    {
+        // Mapping can fail on some file systems, so fall back to reading the file
+        data = LoadFileData(fileName, &dataSize);
+        storage = RAYTEX_BLOB_LOADED;
+    }
+    if (data == NULL)
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: [%s] Failed to load TeX blob", fileName);
+        return blob;
+    }
+
+    blob.data = data;
+    blob.dataSize = dataSize;
+    blob.storage = storage;
+    if (!rIsRayTeXBlobValid(data, dataSize))
+    {
+        TRACELOG(LOG_WARNING, "RAYTEX: [%s] Invalid TeX blob", fileName);
+        UnloadRayTeXBlob(blob);
+        blob = CLITERAL(RayTeXBlob){ 0 };
+    }
+    else TRACELOG(LOG_INFO, "RAYTEX: [%s] TeX blob loaded successfully (%i bytes)", fileName, dataSize);
+    return blob;
 }
 
-// WARNING: Shallow copies of the elements are created.
-// Unloading them outside of the matrix will also unload them for the matrix,
-// and unloading the matrix will also unload them outside of the matrix.
-RayTeX GenRayTeXMatrix(const char *fmt, ...)
+void UnloadRayTeXBlob(RayTeXBlob blob)
 {
-    int rowCount = 0;
-    int columnCount = 0;
+    if (blob.data == NULL) return;
+
+    if (blob.storage == RAYTEX_BLOB_LOADED) UnloadFileData((unsigned char *)blob.data);
+    else if (blob.storage == RAYTEX_BLOB_MAPPED)
     {
-        int currentRowColumnCount = 0;
-        for (const char *c = fmt; *c; ++c)
+#if defined(_WIN32)
+        UnmapViewOfFile(blob.data);
+#else
+        munmap((void *)blob.data, (size_t)blob.dataSize);
+#endif
+    }
+}
+
+Vector2 MeasureRayTeXBlob(RayTeXBlob blob)
+{
+    Vector2 size = { 0 };
+    if (blob.data == NULL) return size;
+
+    const rBlobHeader *header = (const rBlobHeader *)blob.data;
+    size.x = header->box.width;
+    size.y = header->box.height + header->box.depth;
+    return size;
+}
+
+void DrawRayTeXBlob(RayTeXBlob blob, const Font *fonts, int fontCount, int x, int y, Color color)
+{
+    if (blob.data == NULL) return;
+
+    const rBlobHeader *header = (const rBlobHeader *)blob.data;
+    const rBlobFont *blobFonts = (const rBlobFont *)(blob.data + header->fontsOffset);
+    const rBlobCommand *commands = (const rBlobCommand *)(blob.data + header->commandsOffset);
+    const rBlobGlyph *glyphs = (const rBlobGlyph *)(blob.data + header->glyphsOffset);
+    Font defaultFont = { 0 };
+    if ((fonts == NULL) || (fontCount <= 0))
+    {
+        defaultFont = GetFontDefault();
+        fonts = &defaultFont;
+        fontCount = 1;
+    }
+
+    Vector2 offset = { 0 };
+    offset.x = (float)x;
+    offset.y = (float)y;
+    for (unsigned int i = 0; i < header->commandCount; ++i)
+    {
+        const rBlobCommand *command = &commands[i];
+        const Font *font = (command->fontIndex < fontCount) ? &fonts[command->fontIndex] : &fonts[0];
+        Color commandColor = command->isInheritingColor ? color : command->color;
+        switch (command->type)
         {
-            if (*c != '\\')
+        case TEXCOMMAND_TEXT:
+        {
+            // Stored glyph indices only apply to the same font - any other font looks the codepoints up again
+            const rBlobFont *blobFont = &blobFonts[command->fontIndex];
+            bool isSameFont = (blobFont->baseSize == font->baseSize) && (blobFont->glyphCount == font->glyphCount);
+            rFontGlyphs *fontGlyphs = isSameFont ? NULL : rGetFontGlyphs(*font);
+            for (unsigned int k = command->glyphStart; k < command->glyphStart + command->glyphCount; ++k)
             {
-                ++rowCount;
-                if (currentRowColumnCount > columnCount) columnCount = currentRowColumnCount;
-                currentRowColumnCount = 0;
+                int index = isSameFont ? glyphs[k].index : rGetGlyphIndex(*font, fontGlyphs, glyphs[k].codepoint);
+                Vector2 position = { offset.x + glyphs[k].x, offset.y + command->data[1] };
+                rDrawGlyph(*font, index, position, command->fontSize, commandColor);
             }
-            else ++currentRowColumnCount;
         }
-    }
+            break;
 
-    RayTeX element = { 0 };
-    element.mode = TEXMODE_MATRIX;
-    element.matrix.rowCount = rowCount;
-    element.matrix.columnCount = columnCount;
-    int elementCount = rowCount * columnCount;
-    element.matrix.content = RL_MALLOC(elementCount * sizeof(RayTeXRef));
-    if (element.matrix.content != NULL)
-    {
-        va_list args;
-        va_start(args, fmt);
-        int index = 0;
-        const char *c = fmt;
-        int row = 0;
-        int column = 0;
-        for (const char *c = fmt; *c; ++c)
+        case TEXCOMMAND_RULE:
         {
-            switch (*c)
-            {
-            case ' ': element.matrix.content[index] = RayTeXRefFromValue(GenRayTeXSpace(va_arg(args, int)));           break;
-            case 't': element.matrix.content[index] = RayTeXRefFromValue(GenRayTeXText(va_arg(args, const char*)));    break;
-            case 's': element.matrix.content[index] = RayTeXRefFromValue(GenRayTeXSymbol(va_arg(args, RayTeXSymbol))); break;
-            case 'i': element.matrix.content[index] = RayTeXRefFromValue(GenRayTeXTextf("%i", va_arg(args, int)));     break;
-            case 'v': element.matrix.content[index] = RayTeXRefFromValue(va_arg(args, RayTeX));                        break;
-            case 'p': element.matrix.content[index] = RayTeXRefFromPointer(va_arg(args, RayTeX*));                     break;
-            case '&': element.matrix.content[index] = RayTeXRefFromValue(BLANK_TEX);
-            case '\\':
-                for (; column < columnCount; ++column, ++index) { element.matrix.content[index] = RayTeXRefFromValue(BLANK_TEX); }
-                break;
+            Rectangle rec = { offset.x + command->data[0], offset.y + command->data[1], command->data[2], command->data[3] };
+            raylibDrawSink.DrawRule(NULL, font, rec, &commandColor);
+        }
+            break;
 
-            default: TRACELOG(LOG_WARNING, "RAYTEX: GenRayTeXMatrix() at index %i of fmt \"%s\": meaning of '%c' is unknown", index, fmt, *c);
-            }
-            ++column;
+        case TEXCOMMAND_LINE:
+        {
+            Vector2 startPos = { offset.x + command->data[0], offset.y + command->data[1] };
+            Vector2 endPos = { offset.x + command->data[2], offset.y + command->data[3] };
+            raylibDrawSink.DrawLine(NULL, font, startPos, endPos, &commandColor);
+        }
+            break;
 
-            if (column == columnCount)
-            {
-                column = 0;
-                ++row;
-            }
+        default: TRACELOG(LOG_WARNING, "RAYTEX: Unknown TeX blob command [%i]", command->type);
         }
-        va_end(args);
-        TRACELOG(LOG_INFO, "RAYTEX: TeX matrix with %i elements (%i rows x %i columns) generated successfully", elementCount, rowCount, columnCount);
     }
-    else TRACELOG(LOG_ERROR, "RAYTEX: GenRayTeXMatrix() failed to allocate");
-    return element;
 }
 
-static void UnloadAndFreeRayTeXRefIfOwned(RayTeXRef ref)
+#define MAX_DOCUMENT_STYLES 0xFFFFFF // Styles a RayTeXDocumentNode's 24-bit index can refer to
+
+// Counts what a tree needs in a RayTeXDocument
+static void rCountRayTeXDocument(const RayTeX *tex, int *nodeCount, int *styleCount, int *textSize, int *extentCount)
 {
-    if (ref.isOwned)
+    (*nodeCount)++;
+    if (tex->isOverridingColor || tex->isOverridingFontSize || (tex->overrideFont != NULL)) (*styleCount)++;
+    switch (tex->mode)
     {
-        UnloadRayTeX(*ref.ptr);
-        RL_FREE(ref.ptr);
+    case TEXMODE_TEXT: *textSize += rTextLength(tex) + 1; break;
+    case TEXMODE_FRAC:
+        rCountRayTeXDocument(tex->frac.content[TEX_FRAC_NUMERATOR].ptr, nodeCount, styleCount, textSize, extentCount);
+        rCountRayTeXDocument(tex->frac.content[TEX_FRAC_DENOMINATOR].ptr, nodeCount, styleCount, textSize, extentCount);
+        break;
+    case TEXMODE_HORIZONTAL:
+        for (int i = 0; i < tex->horizontal.elementCount; ++i) rCountRayTeXDocument(tex->horizontal.content[i].ptr, nodeCount, styleCount, textSize, extentCount);
+        break;
+    case TEXMODE_VERTICAL:
+        for (int i = 0; i < tex->vertical.elementCount; ++i) rCountRayTeXDocument(tex->vertical.content[i].ptr, nodeCount, styleCount, textSize, extentCount);
+        break;
+    case TEXMODE_MATRIX:
+        if (tex->matrix.columnCount + 2*tex->matrix.rowCount > *extentCount) *extentCount = tex->matrix.columnCount + 2*tex->matrix.rowCount;
+        for (int i = 0; i < tex->matrix.rowCount * tex->matrix.columnCount; ++i) rCountRayTeXDocument(tex->matrix.content[i].ptr, nodeCount, styleCount, textSize, extentCount);
+        break;
+    default: break;
     }
-    else TRACELOG(LOG_INFO, "RAYTEX: potentially-shared child visited during unloading process has not been unloaded");
 }
 
-void UnloadRayTeX(RayTeX tex)
+// Appends the tree to the document in depth-first order
+static void rFillRayTeXDocument(RayTeXDocument *document, const RayTeX *tex, int *textSize)
 {
-    RL_FREE(tex.overrideFont);
-    switch (tex.mode)
+    unsigned int index = (unsigned int)document->nodeCount++;
+    RayTeXDocumentNode *node = &document->nodes[index];
+    node->mode = (unsigned char)tex->mode;
+
+    if ((tex->isOverridingColor || tex->isOverridingFontSize || (tex->overrideFont != NULL)) && (document->styleCount < MAX_DOCUMENT_STYLES))
     {
-    case TEXMODE_SPACE:
-        TRACELOG(LOG_INFO, "RAYTEX: TeX horizontal space element unloaded successfully");
-        break;
+        RayTeXDocumentStyle *style = &document->styles[document->styleCount++];
+        style->isOverridingColor = tex->isOverridingColor;
+        style->isOverridingFontSize = tex->isOverridingFontSize;
+        style->isOverridingFont = (tex->overrideFont != NULL);
+        style->color = tex->overrideColor;
+        style->fontSize = tex->overrideFontSize;
+        if (tex->overrideFont != NULL) style->font = *tex->overrideFont;
+        node->style = (unsigned int)document->styleCount;
+    }
 
+    switch (tex->mode)
+    {
+    case TEXMODE_SPACE:
     case TEXMODE_VSPACE:
-        TRACELOG(LOG_INFO, "RAYTEX: TeX vertical space element unloaded successfully");
+        node->a = tex->space.size;
         break;
 
     case TEXMODE_TEXT:
-        if (tex.text.isOwned) RL_FREE(tex.text.content);
-        TRACELOG(LOG_INFO, "RAYTEX: TeX text element unloaded successfully");
+    {
+        int length = rTextLength(tex);
+        memcpy(document->text + *textSize, rTextContent(tex), length);
+        document->text[*textSize + length] = '\0';
+        node->a = *textSize;
+        node->b = length;
+        *textSize += length + 1;
+    }
         break;
 
     case TEXMODE_SYMBOL:
-        TRACELOG(LOG_INFO, "RAYTEX: TeX symbol element unloaded successfully");
+        node->a = tex->symbol.content;
         break;
 
     case TEXMODE_FRAC:
-        UnloadAndFreeRayTeXRefIfOwned(tex.frac.content[TEX_FRAC_NUMERATOR]);
-        UnloadAndFreeRayTeXRefIfOwned(tex.frac.content[TEX_FRAC_DENOMINATOR]);
-        TRACELOG(LOG_INFO, "RAYTEX: TeX fraction element unloaded successfully");
+        node->a = 2;
+        rFillRayTeXDocument(document, tex->frac.content[TEX_FRAC_NUMERATOR].ptr, textSize);
+        rFillRayTeXDocument(document, tex->frac.content[TEX_FRAC_DENOMINATOR].ptr, textSize);
         break;
 
     case TEXMODE_HORIZONTAL:
-        for (int i = 0; i < tex.horizontal.elementCount; ++i)
-        {
-            UnloadAndFreeRayTeXRefIfOwned(tex.horizontal.content[i]);
-        }
-        RL_FREE(tex.horizontal.content);
-        TRACELOG(LOG_INFO, "RAYTEX: TeX horizontal element unloaded successfully");
+        node->a = tex->horizontal.elementCount;
+        for (int i = 0; i < tex->horizontal.elementCount; ++i) rFillRayTeXDocument(document, tex->horizontal.content[i].ptr, textSize);
         break;
 
     case TEXMODE_VERTICAL:
-        for (int i = 0; i < tex.vertical.elementCount; ++i)
-        {
-            UnloadAndFreeRayTeXRefIfOwned(tex.vertical.content[i]);
-        }
-        RL_FREE(tex.vertical.content);
-        TRACELOG(LOG_INFO, "RAYTEX: TeX vertical element unloaded successfully");
+        node->a = tex->vertical.elementCount;
+        for (int i = 0; i < tex->vertical.elementCount; ++i) rFillRayTeXDocument(document, tex->vertical.content[i].ptr, textSize);
         break;
 
     case TEXMODE_MATRIX:
-        for (int i = 0; i < tex.matrix.rowCount * tex.matrix.columnCount; ++i)
-        {
-            UnloadAndFreeRayTeXRefIfOwned(tex.matrix.content[i]);
-        }
-        RL_FREE(tex.matrix.content);
-        TRACELOG(LOG_INFO, "RAYTEX: TeX matrix element unloaded successfully");
+        node->a = tex->matrix.rowCount * tex->matrix.columnCount;
+        node->b = tex->matrix.columnCount;
+        for (int i = 0; i < tex->matrix.rowCount * tex->matrix.columnCount; ++i) rFillRayTeXDocument(document, tex->matrix.content[i].ptr, textSize);
         break;
 
-    default: TRACELOG(LOG_WARNING, "RAYTEX: Failed to unload TeX element with unknown mode [%i]", tex.mode);
+    default: TRACELOG(LOG_WARNING, "RAYTEX: Unknown mode [%i]", tex->mode);
     }
+
+    document->nodes[index].next = (unsigned int)document->nodeCount;
 }
 
-static void rDrawRayTeX(const Font *font, const RayTeX *tex, Vector2 position, float fontSize, Color color)
+static bool rIsRayTeXDocumentContainer(const RayTeXDocumentNode *node)
 {
-    if (tex->isOverridingColor) color = tex->overrideColor;
-    if (tex->isOverridingFontSize) fontSize = (float)tex->overrideFontSize;
-    if (tex->overrideFont != NULL) font = tex->overrideFont;
-
-    // boxes around everything
-#if 0
-    Vector2 texSize = rMeasureRayTeX(font, tex, fontSize);
-    DrawRectangleLines(position.x, position.y, texSize.x, texSize.y, MAGENTA);
-#endif
+    return (node->mode == TEXMODE_FRAC) || (node->mode == TEXMODE_HORIZONTAL) ||
+           (node->mode == TEXMODE_VERTICAL) || (node->mode == TEXMODE_MATRIX);
+}
 
-    switch (tex->mode)
+RayTeXDocument LoadRayTeXDocument(RayTeX tex)
+{
+    RayTeXDocument document = { 0 };
+    int nodeCount = 0;
+    int styleCount = 0;
+    int textSize = 0;
+    int extentCount = 0;
+    rCountRayTeXDocument(&tex, &nodeCount, &styleCount, &textSize, &extentCount);
+    if (styleCount > MAX_DOCUMENT_STYLES)
     {
-    case TEXMODE_SPACE:
-    case TEXMODE_VSPACE:
-        break;
-
-    case TEXMODE_TEXT:
-        DrawTextEx(*font, tex->text.content, position, fontSize, fontSize / 10, color);
-        break;
+        TRACELOG(LOG_WARNING, "RAYTEX: TeX document has %i overriding nodes, only the first %i keep their overrides", styleCount, MAX_DOCUMENT_STYLES);
+        styleCount = MAX_DOCUMENT_STYLES;
+    }
 
-    case TEXMODE_SYMBOL:
-        DrawRayTeXSymbolEx(*font, tex->symbol.content, position, fontSize, color);
-        break;
+    document.nodes = RL_CALLOC(nodeCount, sizeof(RayTeXDocumentNode));
+    document.styles = RL_CALLOC((styleCount > 0) ? styleCount : 1, sizeof(RayTeXDocumentStyle));
+    document.text = RL_MALLOC((textSize > 0) ? textSize : 1);
+    document.extents = RL_MALLOC((extentCount + 1)*sizeof(float));
+    document.boxes = RL_CALLOC(nodeCount, sizeof(RayTeXBox));
+    document.offsets = RL_CALLOC(nodeCount, sizeof(Vector2));
+    document.state = RL_CALLOC(nodeCount, sizeof(RayTeXDocumentState));
 
-    case TEXMODE_FRAC:
+    if ((document.nodes != NULL) && (document.styles != NULL) && (document.text != NULL) && (document.extents != NULL) &&
+        (document.boxes != NULL) && (document.offsets != NULL) && (document.state != NULL))
+    {
+        textSize = 0;
+        rFillRayTeXDocument(&document, &tex, &textSize);
+        TRACELOG(LOG_INFO, "RAYTEX: TeX document with %i nodes and %i styles loaded successfully", document.nodeCount, document.styleCount);
+    }
+    else
     {
-        RayTeX *numerator = tex->frac.content[TEX_FRAC_NUMERATOR].ptr;
-        RayTeX *denominator = tex->frac.content[TEX_FRAC_DENOMINATOR].ptr;
-        
-        Vector2 size = rMeasureRayTeX(font, tex, fontSize);
-        Vector2 numeratorSize = rMeasureRayTeX(font, numerator, fontSize);
-        Vector2 denominatorSize = rMeasureRayTeX(font, denominator, fontSize);
+        TRACELOG(LOG_ERROR, "RAYTEX: LoadRayTeXDocument() failed to allocate");
+        UnloadRayTeXDocument(document);
+        document = (RayTeXDocument){ 0 };
+    }
+    return document;
+}
 
-        float spacing = MU_TO_PIXELS((float)TEXFRAC_SPACING, fontSize);
+void UnloadRayTeXDocument(RayTeXDocument document)
+{
+    RL_FREE(document.nodes);
+    RL_FREE(document.styles);
+    RL_FREE(document.text);
+    RL_FREE(document.extents);
+    RL_FREE(document.boxes);
+    RL_FREE(document.offsets);
+    RL_FREE(document.state);
+    TRACELOG(LOG_INFO, "RAYTEX: TeX document unloaded successfully");
+}
 
-        Vector2 numeratorPosition = { 0 };
-        numeratorPosition.x = position.x + (size.x - numeratorSize.x) / 2.0f;
-        numeratorPosition.y = position.y;
-        rDrawRayTeX(font, numerator, numeratorPosition, fontSize, color);
+static const Font *rRayTeXDocumentFont(const RayTeXDocument *document, const Font *font, unsigned int fontStyle)
+{
+    return (fontStyle == 0) ? font : &document->styles[fontStyle - 1].font;
+}
 
-        Rectangle ruleRec = { 0 };
-        ruleRec.x = position.x;
-        ruleRec.y = position.y + numeratorSize.y + spacing;
-        ruleRec.width = size.x;
-        ruleRec.height = MU_TO_PIXELS((float)TEXFRAC_THICKNESS, fontSize);
-        DrawRectangleRec(ruleRec, color);
+// Same layout as rLayoutRayTeX(), as two sequential sweeps over the node array instead of a recursive walk
+static void rLayoutRayTeXDocument(const Font *font, RayTeXDocument *document, float fontSize)
+{
+    if (document->isLayoutValid && (document->layoutFontId == font->glyphs) && (document->layoutFontBaseSize == font->baseSize) &&
+        (document->layoutFontGlyphCount == font->glyphCount) && (document->layoutFontSize == fontSize)) return;
+    if (document->nodeCount == 0) return;
 
-        Vector2 denominatorPosition = { 0 };
-        denominatorPosition.x = position.x + (size.x - denominatorSize.x) / 2.0f;
-        denominatorPosition.y = ruleRec.y + ruleRec.height + spacing;
-        rDrawRayTeX(font, denominator, denominatorPosition, fontSize, color);
+    RayTeXDocumentNode *nodes = document->nodes;
+    RayTeXDocumentState *state = document->state;
 
+    // Top-down: resolve inherited font and font size, parents always come before their children
+    state[0].fontSize = fontSize;
+    state[0].fontStyle = 0;
+    for (int i = 0; i < document->nodeCount; ++i)
+    {
+        if (nodes[i].style != 0)
+        {
+            const RayTeXDocumentStyle *style = &document->styles[nodes[i].style - 1];
+            if (style->isOverridingFontSize) state[i].fontSize = (float)style->fontSize;
+            if (style->isOverridingFont) state[i].fontStyle = nodes[i].style;
+        }
+        if (rIsRayTeXDocumentContainer(&nodes[i]))
+        {
+            unsigned int child = (unsigned int)i + 1;
+            for (int k = 0; k < nodes[i].a; ++k, child = nodes[child].next)
+            {
+                state[child].fontSize = state[i].fontSize;
+                state[child].fontStyle = state[i].fontStyle;
+            }
+        }
     }
-        break;
 
-    case TEXMODE_HORIZONTAL:
+    // Bottom-up: children always come after their parents, so a reverse sweep sees them first
+    for (int i = document->nodeCount - 1; i >= 0; --i)
     {
-        float yOffsetExtra = 0.0f;
-        for (int i = 0; i < tex->horizontal.elementCount; ++i)
+        const RayTeXDocumentNode *node = &nodes[i];
+        const Font *nodeFont = rRayTeXDocumentFont(document, font, state[i].fontStyle);
+        float nodeFontSize = state[i].fontSize;
+        unsigned int firstChild = (unsigned int)i + 1;
+        RayTeXBox box = { 0 };
+        switch (node->mode)
+        {
+        case TEXMODE_SPACE: box.width = MU_TO_PIXELS((float)node->a, nodeFontSize); break;
+        case TEXMODE_VSPACE: box.height = MU_TO_PIXELS((float)node->a, nodeFontSize); break;
+        case TEXMODE_TEXT: box = rTextBox(&glyphCache, nodeFont, document->text + node->a, 0, nodeFontSize); break;
+        case TEXMODE_SYMBOL: box = rSymbolBox(&glyphCache, nodeFont, (RayTeXSymbol)node->a, nodeFontSize); break;
+
+        case TEXMODE_FRAC:
         {
-            RayTeX *element = tex->horizontal.content[i].ptr;
-            if (element->mode == TEXMODE_FRAC)
+            unsigned int denominator = nodes[firstChild].next;
+            Vector2 offsets[2] = { 0 };
+            box = rFracBox(document->boxes[firstChild], document->boxes[denominator], nodeFontSize, offsets);
+            document->offsets[firstChild] = offsets[TEX_FRAC_NUMERATOR];
+            document->offsets[denominator] = offsets[TEX_FRAC_DENOMINATOR];
+        }
+            break;
+
+        case TEXMODE_HORIZONTAL:
+        {
+            unsigned int child = firstChild;
+            for (int k = 0; k < node->a; ++k, child = nodes[child].next)
+            {
+                RayTeXBox elementBox = document->boxes[child];
+                box.width += elementBox.width;
+                if (elementBox.height > box.height) box.height = elementBox.height;
+                if (elementBox.depth > box.depth) box.depth = elementBox.depth;
+            }
+
+            float x = 0.0f;
+            child = firstChild;
+            for (int k = 0; k < node->a; ++k, child = nodes[child].next)
             {
-                float spacing = MU_TO_PIXELS((float)TEXFRAC_SPACING, fontSize);
-                const Vector2 numeratorSize = rMeasureRayTeX(font, element->frac.content[TEX_FRAC_NUMERATOR].ptr, fontSize);
-                const Vector2 denominatorSize = rMeasureRayTeX(font, element->frac.content[TEX_FRAC_DENOMINATOR].ptr, fontSize);
-                float excess = (numeratorSize.y - denominatorSize.y + spacing + TEXFRAC_THICKNESS / 2.0f) / 2;
-                if (excess > yOffsetExtra) yOffsetExtra = excess;
+                document->offsets[child].x = x;
+                document->offsets[child].y = box.height - document->boxes[child].height;
+                x += document->boxes[child].width;
             }
         }
-        position.y += yOffsetExtra;
-        Vector2 horizontalSize = rMeasureRayTeX(font, tex, fontSize);
-        for (int i = 0; i < tex->horizontal.elementCount; ++i)
+            break;
+
+        case TEXMODE_VERTICAL:
         {
-            RayTeX *element = tex->horizontal.content[i].ptr;
-            const Vector2 size = rMeasureRayTeX(font, element, fontSize);
-            float yOffset = (horizontalSize.y - size.y) / 2;
-            if (element->mode == TEXMODE_FRAC)
+            float totalHeight = 0.0f;
+            unsigned int child = firstChild;
+            for (int k = 0; k < node->a; ++k, child = nodes[child].next)
             {
-                float spacing = MU_TO_PIXELS((float)TEXFRAC_SPACING, fontSize);
-                const Vector2 numeratorSize = rMeasureRayTeX(font, element->frac.content[TEX_FRAC_NUMERATOR].ptr, fontSize);
-                const Vector2 denominatorSize = rMeasureRayTeX(font, element->frac.content[TEX_FRAC_DENOMINATOR].ptr, fontSize);
-                yOffset = yOffset - (numeratorSize.y - denominatorSize.y + spacing + TEXFRAC_THICKNESS / 2.0f) / 2;
+                RayTeXBox elementBox = document->boxes[child];
+                if (elementBox.width > box.width) box.width = elementBox.width;
+                totalHeight += elementBox.height + elementBox.depth;
+            }
+            box.height = totalHeight / 2.0f;
+            box.depth = totalHeight / 2.0f;
+
+            float y = 0.0f;
+            child = firstChild;
+            for (int k = 0; k < node->a; ++k, child = nodes[child].next)
+            {
+                document->offsets[child].x = (box.width - document->boxes[child].width) / 2.0f;
+                document->offsets[child].y = y;
+                y += document->boxes[child].height + document->boxes[child].depth;
             }
-            Vector2 positionWithOffset = { 0 };
-            positionWithOffset.x = position.x;
-            positionWithOffset.y = position.y + yOffset;
-            rDrawRayTeX(font, element, positionWithOffset, fontSize, color);
-            position.x += size.x;
         }
-    }
-        break;
+            break;
 
-    case TEXMODE_VERTICAL:
-    {
-        Vector2 verticalSize = rMeasureRayTeX(font, tex, fontSize);
-        for (int i = 0; i < tex->vertical.elementCount; ++i)
+        case TEXMODE_MATRIX:
         {
-            const RayTeX *element = tex->vertical.content[i].ptr;
-            const Vector2 size = rMeasureRayTeX(font, element, fontSize);
-            float xOffset = (verticalSize.x - size.x) / 2;
-            Vector2 positionWithOffset = { 0 };
-            positionWithOffset.x = position.x + xOffset;
-            positionWithOffset.y = position.y;
-            rDrawRayTeX(font, element, positionWithOffset, fontSize, color);
-            position.y += size.y;
-        }
-    }
-        break;
+            // Same as the tree, with the column and row extents in the document's scratch memory, sized for its largest matrix
+            int columnCount = node->b;
+            int rowCount = (columnCount > 0) ? node->a / columnCount : 0;
+            float *extents = document->extents;
+            memset(extents, 0, (columnCount + 2*rowCount)*sizeof(float));
+            float *columnWidths = extents;
+            float *rowHeights = columnWidths + columnCount;
+            float *rowDepths = rowHeights + rowCount;
 
-    case TEXMODE_MATRIX: // todo
-        TRACELOG(LOG_WARNING, "RAYTEX: TEXMODE_MATRIX draw not yet implemented");
-        break;
+            unsigned int child = firstChild;
+            for (int k = 0; k < rowCount*columnCount; ++k, child = nodes[child].next)
+            {
+                RayTeXBox cellBox = document->boxes[child];
+                int row = k / columnCount;
+                int column = k % columnCount;
+                if (cellBox.width > columnWidths[column]) columnWidths[column] = cellBox.width;
+                if (cellBox.height > rowHeights[row]) rowHeights[row] = cellBox.height;
+                if (cellBox.depth > rowDepths[row]) rowDepths[row] = cellBox.depth;
+            }
+            box = rMatrixBox(rowCount, columnCount, columnWidths, rowHeights, rowDepths, nodeFontSize);
 
-    default: TRACELOG(LOG_WARNING, "RAYTEX: Unknown mode [%i]", tex->mode);
+            float columnSpacing = MU_TO_PIXELS((float)TEXMATRIX_COLUMN_SPACING, nodeFontSize);
+            float rowSpacing = MU_TO_PIXELS((float)TEXMATRIX_ROW_SPACING, nodeFontSize);
+            float x = 0.0f;
+            float y = 0.0f;
+            child = firstChild;
+            for (int k = 0; k < rowCount*columnCount; ++k, child = nodes[child].next)
+            {
+                int row = k / columnCount;
+                int column = k % columnCount;
+                if ((column == 0) && (row > 0))
+                {
+                    x = 0.0f;
+                    y += rowHeights[row - 1] + rowDepths[row - 1] + rowSpacing;
+                }
+                document->offsets[child].x = x + (columnWidths[column] - document->boxes[child].width) / 2.0f;
+                document->offsets[child].y = y + rowHeights[row] - document->boxes[child].height;
+                x += columnWidths[column] + columnSpacing;
+            }
+        }
+            break;
+
+        default: TRACELOG(LOG_WARNING, "RAYTEX: Unknown mode [%i]", node->mode);
+        }
+        document->boxes[i] = box;
     }
-}
 
-void DrawRayTeX(RayTeX tex, int x, int y, int fontSize, Color color)
-{
-    DrawRayTeXEx(GetFontDefault(), tex, x, y, fontSize, color);
+    document->layoutFontId = font->glyphs;
+    document->layoutFontBaseSize = font->baseSize;
+    document->layoutFontGlyphCount = font->glyphCount;
+    document->layoutFontSize = fontSize;
+    document->isLayoutValid = true;
 }
 
-void DrawRayTeXEx(Font font, RayTeX tex, int x, int y, int fontSize, Color color)
+Vector2 MeasureRayTeXDocument(Font font, RayTeXDocument *document, int fontSize)
 {
-    Vector2 position = { 0 };
-    position.x = (float)x;
-    position.y = (float)y;
-    rDrawRayTeX(&font, &tex, position, (float)fontSize, color);
+    Vector2 size = { 0 };
+    rLayoutRayTeXDocument(&font, document, (float)fontSize);
+    if (document->nodeCount > 0)
+    {
+        size.x = document->boxes[0].width;
+        size.y = document->boxes[0].height + document->boxes[0].depth;
+    }
+    return size;
 }
 
-static void rDrawRayTeXCentered(const Font *font, const RayTeX *tex, Rectangle rec, float fontSize, Color color)
+void DrawRayTeXDocument(Font font, RayTeXDocument *document, int x, int y, int fontSize, Color color)
 {
-    Vector2 texSize = rMeasureRayTeX(font, tex, fontSize);
-    Vector2 position = { 0 };
-    position.x = rec.x + (rec.width - texSize.x) / 2.0f;
-    position.y = rec.y + (rec.height - texSize.y) / 2.0f;
-    rDrawRayTeX(font, tex, position, fontSize, color);
-}
+    rLayoutRayTeXDocument(&font, document, (float)fontSize);
+    if (document->nodeCount == 0) return;
 
-void DrawRayTeXCentered(RayTeX tex, int x, int y, int width, int height, int fontSize, Color color)
-{
-    Rectangle rec = { 0 };
-    rec.x = (float)x;
-    rec.y = (float)y;
-    rec.width = (float)width;
-    rec.height = (float)height;
-    DrawRayTeXCenteredRec(tex, rec, fontSize, color);
-}
+    const RayTeXDocumentNode *nodes = document->nodes;
+    RayTeXDocumentState *state = document->state;
+    state[0].position.x = (float)x;
+    state[0].position.y = (float)y;
+    state[0].colorStyle = 0;
 
-void DrawRayTeXCenteredRec(RayTeX tex, Rectangle rec, int fontSize, Color color)
-{
-    DrawRayTeXCenteredPro(GetFontDefault(), tex, rec, (float)fontSize, color);
-}
+    // Single forward sweep - positions and colors are pushed down to children before they are reached
+    for (int i = 0; i < document->nodeCount; ++i)
+    {
+        const RayTeXDocumentNode *node = &nodes[i];
+        if ((node->style != 0) && document->styles[node->style - 1].isOverridingColor) state[i].colorStyle = node->style;
 
-void DrawRayTeXCenteredPro(Font font, RayTeX tex, Rectangle rec, float fontSize, Color color)
-{
-    rDrawRayTeXCentered(&font, &tex, rec, fontSize, color);
+        const Font *nodeFont = rRayTeXDocumentFont(document, &font, state[i].fontStyle);
+        const Color *nodeColor = (state[i].colorStyle == 0) ? &color : &document->styles[state[i].colorStyle - 1].color;
+        Vector2 position = state[i].position;
+        switch (node->mode)
+        {
+        case TEXMODE_TEXT:
+            raylibDrawSink.DrawText(NULL, nodeFont, document->text + node->a, 0, position, state[i].fontSize, nodeColor);
+            break;
+
+        case TEXMODE_SYMBOL:
+        {
+            Vector2 size = { document->boxes[i].width, document->boxes[i].height + document->boxes[i].depth };
+            rDrawRayTeXSymbol(&raylibDrawSink, nodeFont, (RayTeXSymbol)node->a, position, size, state[i].fontSize, nodeColor);
+        }
+            break;
+
+        case TEXMODE_FRAC:
+            raylibDrawSink.DrawRule(NULL, nodeFont, rFracRule(document->boxes[i], position, state[i].fontSize), nodeColor);
+            break;
+
+        default: break;
+        }
+
+        if (rIsRayTeXDocumentContainer(node))
+        {
+            unsigned int child = (unsigned int)i + 1;
+            for (int k = 0; k < node->a; ++k, child = nodes[child].next)
+            {
+                state[child].position.x = position.x + document->offsets[child].x;
+                state[child].position.y = position.y + document->offsets[child].y;
+                state[child].colorStyle = state[i].colorStyle;
+            }
+        }
+    }
 }
@@ -1,17 +1,81 @@
 #ifndef RAYTEX_H
 #define RAYTEX_H
 #include <stdarg.h>
+#include <stddef.h>
 #include <raylib.h>
 
-typedef enum {
-    TEXSYMBOL_NEQ,
-} RayTeXSymbol;
+// Allocator used for elements, child arrays and owned text by every GenRayTeX*() call
+// Elements must be unloaded while the allocator they were generated with is still set
+typedef struct RayTeXAllocator {
+    void *userData;
+    void *(*Alloc)(void *userData, size_t size);
+    void (*Free)(void *userData, void *ptr);
+} RayTeXAllocator;
+
+void SetRayTeXAllocator(RayTeXAllocator allocator);
+RayTeXAllocator GetRayTeXAllocator(void);
+RayTeXAllocator GetRayTeXDefaultAllocator(void); // RL_MALLOC/RL_FREE
+
+// Bump allocator for formulas that are rebuilt often
+// Everything generated while its allocator is set is released at once by ResetRayTeXArena(), without UnloadRayTeX()
+typedef struct RayTeXArena {
+    int blockSize;
+    struct RayTeXArenaBlock *blocks; // Most recently started first
+    size_t used;                     // Bytes used in the first block
+} RayTeXArena;
+
+RayTeXArena LoadRayTeXArena(int blockSize);            // 0 for the default block size
+void ResetRayTeXArena(RayTeXArena *arena);             // Releases everything allocated from the arena
+void UnloadRayTeXArena(RayTeXArena *arena);
+RayTeXAllocator RayTeXArenaAllocator(RayTeXArena *arena);
+
+// Deduplicates repeated subtrees while it is set: every child generated by GenRayTeX*() or ParseRayTeX() that is equal
+// to one interned before is replaced by a pointer to that one, which is laid out once per font and font size.
+// Interned elements belong to the interner. Do not edit them, and unload the trees that use them before the interner.
+// Text that the elements do not own (GenRayTeXText(), ParseRayTeX()) must outlive the interner.
+typedef struct RayTeXInterner {
+    int capacity;          // Power of two, 0 until the first element is interned
+    int count;
+    struct RayTeX **nodes; // Open-addressed hash set, NULL for empty slots
+} RayTeXInterner;
+
+RayTeXInterner LoadRayTeXInterner(void);
+void UnloadRayTeXInterner(RayTeXInterner *interner); // Unloads every interned element
+void SetRayTeXInterner(RayTeXInterner *interner);    // NULL stops interning
+
+// Counters for finding out why a formula is slow, kept only when raytex.c is built with RAYTEX_STATS defined.
+// Without it every counter compiles out and GetRayTeXStats() returns zeros.
+typedef struct RayTeXStats {
+    long long layoutCount;       // Elements visited by layout
+    long long layoutCacheHits;   // Elements whose cached layout was reused
+    long long layoutCacheMisses; // Elements laid out again
+    long long drawNodeCount;     // Elements visited while drawing, compiling or rendering
+    long long drawCulledCount;   // Elements skipped with everything below them by DrawRayTeXClipped()
+    long long measureTextCount;  // Text measured or shaped
+    long long drawTextCount;     // Text drawn to the screen, as strings or glyph runs
+    long long bytesAllocated;    // Through the RayTeX allocator
+    long long bytesFreed;        // Through the RayTeX allocator
+    long long liveNodeCount;     // Children owned by trees or interners that are not unloaded yet - roots are held by value and not counted
+    long long internHits;        // Children replaced by an element interned before
+    double measureTime;          // Seconds spent in MeasureRayTeX*() and LayoutRayTeX()
+    double drawTime;             // Seconds spent in DrawRayTeXEx(), DrawRayTeXLayout*(), DrawRayTeXClipped() and DrawRayTeXCentered*(), including their layout
+} RayTeXStats;
+
+// Called when a timed scope ("MeasureRayTeX" or "DrawRayTeX") starts and ends, e.g. to forward it to a profiler
+typedef void (*RayTeXStatsScopeCallback)(const char *scope, bool isEnd);
+
+RayTeXStats GetRayTeXStats(void);
+void ResetRayTeXStats(void); // Call once per frame for per-frame counts. Keeps liveNodeCount.
+void SetRayTeXStatsScopeCallback(RayTeXStatsScopeCallback callback);
+
+#include "raytex_symbols.h" // RayTeXSymbol, generated by tools/gen_raytex_symbols.py
 
 #define TEX_BACKSLASH "\\\\"
 #define TEX_NEQ       "\\neq"
 #define TEX_HRULE     "\\hrule"
 
-RayTeXSymbol RayTeXSymbolFromName(const char *name);
+RayTeXSymbol RayTeXSymbolFromName(const char *name);      // TEXSYMBOL_UNKNOWN if there is no symbol with that name
+int GetRayTeXSymbolCodepoint(RayTeXSymbol symbol);      // Useful for loading fonts that contain every symbol
 Vector2 MeasureRayTeXSymbolEx(Font font, RayTeXSymbol symbol, float fontSize);
 int MeasureRayTeXSymbolWidth(RayTeXSymbol symbol, int fontSize);
 int MeasureRayTeXSymbolHeight(RayTeXSymbol symbol, int fontSize);
@@ -71,21 +135,53 @@ enum {
     TEX_FRAC_DENOMINATOR = 1,
 };
 
+// Bytes of formatted text (including the terminator) that text elements hold without an allocation
+#ifndef RAYTEX_INLINE_TEXT_SIZE
+    #define RAYTEX_INLINE_TEXT_SIZE 16
+#endif
+
 struct RayTeX;
 
 typedef struct RayTeXRef {
-    bool isOwned;
+    bool isOwned;       // Holds one of the element's references - false for children added by pointer or interned
     struct RayTeX *ptr;
 } RayTeXRef;
 
+// TeX-style box - the baseline is the math axis, which runs through the middle of a line of text
+typedef struct RayTeXBox {
+    float width;
+    float height;       // Extent above the baseline
+    float depth;        // Extent below the baseline
+} RayTeXBox;
+
+typedef struct RayTeXLayout {
+    const void *fontId; // Identity of the font the layout was computed with
+    float fontSize;     // Font size the layout was computed with, 1 if it is scale-free
+    RayTeXBox box;
+    bool isValid;       // Cleared by anything that affects layout (color changes do not)
+    bool isScaleFree;   // Nothing below overrides the font size, so box and offsets are in units of the font size and valid at any size
+    unsigned int version;       // Changes whenever the layout is recomputed
+    unsigned int childVersions; // Sum of the children's versions when the layout was computed
+    bool isChildChanged;        // Something below was edited since the element was last laid out
+    bool isOrdered;             // Children follow one another along the element's axis without overlapping, so drawing can bisect them
+    unsigned int editCount;     // Edits to elements with unknown parents, as counted when the element was last laid out
+    struct RayTeXSharedLayouts *sharedLayouts; // Layouts for other fonts and font sizes, only kept by interned elements
+} RayTeXLayout;
+
 typedef struct RayTeX {
+    RayTeXLayout layout;              // Cached by measuring/drawing - use InvalidateRayTeXLayout() after editing fields directly
     Color overrideColor;
     int overrideFontSize;
     Font *overrideFont;               // NULL if not overriding
+    int refCount;                     // Owning RayTeXRefs to the element - a child is unloaded when its last one is released
+    struct RayTeX *parent;            // Set by layout on children only this element owns, so that edits can mark the way up - NULL while unknown
     int isOverridingColor    : 1;     // bool
     int isOverridingFontSize : 1;     // bool
     int fillsParentCrossAxis : 1;     // bool
-    int mode : (sizeof(int) * 8 - 3); // TeXMode
+    int isInterned           : 1;     // bool, owned by a RayTeXInterner
+    int isSharing            : 1;     // bool, set when an element this one does not own is somewhere below it
+    int isSlot               : 1;     // bool, text parsed from \slot{name}
+    int mode : (sizeof(int) * 8 - 6); // TeXMode
     union {
         struct {
             int size; // Measured in mu (18 mu = current font size)
@@ -96,35 +192,61 @@ typedef struct RayTeX {
         } symbol;
 
         struct {
-            bool isOwned;
+            bool isOwned;        // content was allocated for the element, and is shared with its clones
+            bool isInline;       // The text is stored in inlineContent and content is NULL - GetRayTeXText() works for both
+            int length;          // Number of bytes in content, 0 if content is null-terminated
             const char *content;
+            int capacity;        // Bytes an owned content has room for, including the terminator
+            int codepointCount;
+            int codepointCapacity;    // Codepoints the decoded buffers have room for
+            int *codepoints;          // Decoded content, owned by the element
+            int *glyphIndices;        // Glyph run, -1 for blank glyphs (same allocation as codepoints, which also records the font it was shaped for)
+            float *glyphOffsets;      // Glyph run at the font's base size (same allocation as codepoints)
+            char inlineContent[RAYTEX_INLINE_TEXT_SIZE]; // Short formatted text, e.g. numbers and names, without an allocation
         } text;
 
         struct {
             RayTeXRef content[2];
+            Vector2 offsets[2]; // Cached child positions relative to the element
         } frac;
 
         struct {
             int elementCount;
             RayTeXRef *content; // elementCount elements
+            Vector2 *offsets;   // elementCount elements, cached child positions relative to the element (same allocation as content)
         } horizontal;
 
         struct {
             int elementCount;
             RayTeXRef *content; // elementCount elements
+            Vector2 *offsets;   // elementCount elements, cached child positions relative to the element (same allocation as content)
         } vertical;
 
         struct {
             int rowCount;
             int columnCount;
-            RayTeXRef *content; // rowCount*columnCount elements
+            RayTeXRef *content;   // rowCount*columnCount elements
+            Vector2 *offsets;     // rowCount*columnCount elements, cached cell positions relative to the element (same allocation as content)
+            float *columnWidths;  // columnCount elements, cached by layout (same allocation as content)
+            float *rowHeights;    // rowCount elements, cached by layout (same allocation as content)
+            float *rowDepths;     // rowCount elements, cached by layout (same allocation as content)
         } matrix;
     };
 } RayTeX;
 
+// Layout only uses a font's glyph metrics (glyphs, recs and baseSize), never its texture.
+// Fonts loaded with LoadRayTeXFontMetrics() have no texture, so measuring, compiling and documents work without InitWindow().
+Font LoadRayTeXFontMetrics(const char *fileName, int fontSize, const int *codepoints, int codepointCount); // Loads a TTF/OTF on the CPU only (codepoints NULL for the default ASCII set)
+void UnloadRayTeXFontMetrics(Font font);
+
+// Containers with at least RAYTEX_PARALLEL_LAYOUT_THRESHOLD children (512 by default) lay their children out on all cores.
+// Containers with shared children below them (added by pointer or interned) are laid out on the calling thread instead.
+// Define the threshold as 0 when building raytex.c to never start threads for layout.
 Vector2 MeasureRayTeXEx(Font font, RayTeX tex, int fontSize);
-int MeasureRayTeXWidth(RayTeX tex, int fontSize);
-int MeasureRayTeXHeight(RayTeX tex, int fontSize);
+RayTeXBox MeasureRayTeXBoxEx(Font font, RayTeX tex, int fontSize);
+int MeasureRayTeXWidth(RayTeX tex, int fontSize);  // Uses GetFontDefault(), which needs a window
+int MeasureRayTeXHeight(RayTeX tex, int fontSize); // Uses GetFontDefault(), which needs a window
+void ClearRayTeXFontCache(void);                 // Frees what is cached about fonts - call after unloading a font that was measured or drawn
 
 void UpdateRayTeXColor(RayTeX *tex, Color color);
 void UpdateRayTeXFontSize(RayTeX *tex, int fontSize);
@@ -132,12 +254,18 @@ void UpdateRayTeXFont(RayTeX *tex, Font font);
 void ClearRayTeXColor(RayTeX *tex);              // Clears the element's override so that it inherits from its parent again
 void ClearRayTeXFontSize(RayTeX *tex);           // Clears the element's override so that it inherits from its parent again
 void ClearRayTeXFont(RayTeX *tex);               // Clears the element's override so that it inherits from its parent again
+void InvalidateRayTeXLayout(RayTeX *tex);        // Forces the element to be laid out again - only needed after editing its fields directly
+void UpdateRayTeXText(RayTeX *tex, const char *text);        // Copies the text into the element, like UpdateRayTeXTextf()
+void UpdateRayTeXTextf(RayTeX *tex, const char *fmt, ...);   // Formats into the element's own storage, which only allocates when the text outgrows it
+const char *GetRayTeXText(const RayTeX *tex, int *length);   // Text of a text element, wherever it is stored - parsed text points into the source and is not null-terminated, so use length (may be NULL)
 
 RayTeX RayTeXColor(RayTeX tex, Color color);     // Sets the TeX color of the element and returns the modified element - useful for initialization
 RayTeX RayTeXFontSize(RayTeX tex, int fontSize); // Sets the TeX font size of the element and returns the modified element - useful for initialization
 RayTeX RayTeXFont(RayTeX tex, Font font);        // Sets the TeX font of the element and returns the modified element - useful for initialization
 
 // Remember that you can also use the `&` operator if you want to update the element itself and not one of its children
+// Children shared with a clone or interned are copied before they are returned, so that edits only change this tree.
+// Pointers returned before CloneRayTeX() was called still point to the shared element.
 
 RayTeX *RayTeXFracNumerator(RayTeX *fracTex);                     // Returns a pointer to the element for updating after initialization
 RayTeX *RayTeXFracDenominator(RayTeX *fracTex);                   // Returns a pointer to the element for updating after initialization
@@ -148,7 +276,7 @@ RayTeX *RayTeXMatrixCell(RayTeX *matrixTex, int row, int column); // Returns a p
 RayTeX GenRayTeXSpace(int mu);
 RayTeX GenRayTeXVSpace(int mu);
 RayTeX GenRayTeXText(const char *content);
-RayTeX GenRayTeXTextf(const char *fmt, ...);      // (sprintf() style)
+RayTeX GenRayTeXTextf(const char *fmt, ...);      // (sprintf() style) Short results are stored in the element itself
 RayTeX GenRayTeXSymbol(RayTeXSymbol symbol);
 RayTeX GenRayTeXFrac(char fmt0, char fmt1, ...);  // fmt: ' ' for space, 't' for text, 'i' for int, 's' for symbol, 'p' for pointer, 'v' for value
 RayTeX GenRayTeXHorizontal(const char *fmt, ...); // fmt: ' ' for space, 't' for text, 'i' for int, 's' for symbol, 'p' for pointer, 'v' for value
@@ -156,16 +284,212 @@ RayTeX GenRayTeXVertical(const char *fmt, ...);   // fmt: ' ' for space, 't' for
 RayTeX GenRayTeXMatrix(const char *fmt, ...);     // fmt: ' ' for space, 't' for text, 'i' for int, 's' for symbol, 'p' for pointer, 'v' for value,
                                                   //      '&' for column skip, '\\' for end of row
 
+// Parses TeX source in a single pass, e.g. "x \\neq \\frac{a}{b}" (as a C string literal)
+// Supports \\frac, symbol names, spacing commands, and matrices with TEX_BACKSLASH between rows and & between columns
+// \\slot{name} is text showing its name, to be replaced through a RayTeXTemplate
+// WARNING: Text elements point into the source instead of copying it, so it must outlive the result.
+RayTeX ParseRayTeX(const char *source); // Returns BLANK_TEX if it runs out of memory
+
+// Copies the element itself, sharing its children and text with it. They stay shared until they are edited through
+// RayTeXFracNumerator() and the other accessors above, which copy only what leads to the edited element. Allocates
+// nothing, however large the tree below it is, unless the element overrides its font or is text.
+RayTeX CloneRayTeX(RayTeX tex);
+
 // Unloads the tex and all owned children.
 // Any child that was added by value is owned. Any child that was added by pointer is unowned.
+// Owned children are unloaded once the last tree referencing them (through CloneRayTeX()) is unloaded.
 // Unowned children will not be unloaded. They may be shared, and need to be unloaded separately.
+// Children added while a RayTeXInterner is set are unowned too, and are unloaded by UnloadRayTeXInterner().
 void UnloadRayTeX(RayTeX tex);
 
 void DrawRayTeX(RayTeX tex, int x, int y, int fontSize, Color color);
 void DrawRayTeXEx(Font font, RayTeX tex, int x, int y, int fontSize, Color color);
+void DrawRayTeXClipped(Font font, RayTeX tex, int x, int y, int fontSize, Color color, Rectangle viewport); // Skips subtrees outside the viewport, e.g. the screen or a scroll area
+void SetRayTeXPixelSnap(int fontSize); // Draws glyphs and rules on whole pixels at font sizes up to this one (0 by default, never)
+
+// The functions above lay out a copy of the element, so its own layout is computed again on every call. These lay it
+// out where it is and keep the layout in it, so that the next call only lays out what was edited below it since.
+// Its children are linked back to it, so once laid out it must stay where it is until it is unloaded, or be laid out
+// again at its new place before anything else is done with it or below it.
+RayTeXBox LayoutRayTeX(Font font, RayTeX *tex, int fontSize); // Returns the element's box, like MeasureRayTeXBoxEx()
+void DrawRayTeXLayout(Font font, RayTeX *tex, int x, int y, int fontSize, Color color);
+void DrawRayTeXLayoutClipped(Font font, RayTeX *tex, int x, int y, int fontSize, Color color, Rectangle viewport);
+
+// Picking and element rectangles lay the element out where it is, like LayoutRayTeX(), so a query after the element was
+// laid out with the same font and font size costs a walk down one path instead of a layout of the whole tree.
+#ifndef RAYTEX_MAX_PICK_DEPTH
+    #define RAYTEX_MAX_PICK_DEPTH 32
+#endif
+
+typedef struct RayTeXPick {
+    int depth;                                    // Levels below the root on the path, -1 if the point is outside the root
+    int indices[RAYTEX_MAX_PICK_DEPTH];           // Child index taken at each level: numerator 0 and denominator 1, list position, or row*columnCount + column
+    RayTeX *elements[RAYTEX_MAX_PICK_DEPTH + 1];  // elements[0] is the root and elements[depth] the deepest element under the point
+    Rectangle rec;                                // Screen rectangle of the deepest element
+} RayTeXPick;
+
+RayTeXPick PickRayTeX(Font font, RayTeX *tex, int x, int y, int fontSize, Vector2 point); // tex drawn at (x, y)
+Rectangle GetRayTeXRec(Font font, RayTeX *tex, int x, int y, int fontSize, const int *indices, int depth); // Screen rectangle of the element at a path, e.g. RayTeXPick.indices
 
 void DrawRayTeXCentered(RayTeX tex, int x, int y, int width, int height, int fontSize, Color color);
 void DrawRayTeXCenteredRec(RayTeX tex, Rectangle rec, int fontSize, Color color);
 void DrawRayTeXCenteredPro(Font font, RayTeX tex, Rectangle rec, float fontSize, Color color);
 
+// Rules and lines are drawn from a white texel in the font's atlas so that a formula stays in one batch.
+// The texel is found by reading the atlas back once per font; set it to skip that, or to an empty rectangle if the atlas has none.
+void SetRayTeXFontWhiteTexel(Font font, Rectangle texel);
+int CountRayTeXBatchBreaks(Font font, RayTeX tex, int fontSize); // Number of times drawing the formula changes texture or primitive mode
+
+// Renders on the CPU with the ImageDraw*() functions, so no window is needed when the font comes from LoadRayTeXFontMetrics()
+Image RenderRayTeXToImage(Font font, RayTeX tex, int fontSize, Color color);
+
+// Renders every formula to the PNG (or other ExportImage() format) with the same index, using all cores
+// Formulas are laid out in place first. They must not share children, since they are rendered in parallel.
+bool ExportRayTeXBatch(Font font, RayTeX *texs, const char **fileNames, int count, int fontSize, Color color);
+
+// Formula parsed once with \\slot{name} placeholders, whose text is set as often as needed (e.g. every frame).
+// Only changed slots and the elements above them are laid out again - everything else keeps its cached layout.
+// The template keeps its layout in itself, like an element laid out with LayoutRayTeX(), so it must stay where it is too.
+// Do not clone the tree or edit it through the RayTeX*Child() accessors, since the slots keep pointers into it.
+typedef struct RayTeXTemplate {
+    RayTeX tex;
+    int slotCount;
+    struct RayTeXTemplateSlot *slots;
+} RayTeXTemplate;
+
+RayTeXTemplate LoadRayTeXTemplate(const char *source); // The source must outlive the template, as with ParseRayTeX()
+void UnloadRayTeXTemplate(RayTeXTemplate tmpl);
+int GetRayTeXTemplateSlot(RayTeXTemplate tmpl, const char *name); // Returns -1 if there is no slot with that name
+void SetRayTeXTemplateSlot(RayTeXTemplate *tmpl, int slot, const char *text);
+void SetRayTeXTemplateSlotf(RayTeXTemplate *tmpl, int slot, const char *fmt, ...);
+RayTeXBox MeasureRayTeXTemplate(Font font, RayTeXTemplate *tmpl, int fontSize);
+void DrawRayTeXTemplate(Font font, RayTeXTemplate *tmpl, int x, int y, int fontSize, Color color);
+
+typedef enum {
+    TEXCOMMAND_TEXT,
+    TEXCOMMAND_RULE,
+    TEXCOMMAND_LINE,
+} RayTeXCommandType;
+
+// Glyph of a compiled glyph run
+typedef struct RayTeXCompiledGlyph {
+    int index; // Into the command's font
+    float x;   // Relative to the formula, with scaling and spacing applied
+} RayTeXCompiledGlyph;
+
+typedef struct RayTeXCommand {
+    RayTeXCommandType type;
+    bool isInheritingColor; // Drawn with the color passed to DrawRayTeXCompiled() instead of `color`
+    Color color;
+    int fontIndex;          // Into the compiled formula's fonts - rules and lines are drawn from its atlas, so that they batch with the glyphs
+    union {
+        struct {
+            float y;
+            float fontSize;
+            int glyphStart;     // Into the compiled formula's glyphs
+            int glyphCount;
+        } text;                 // Glyph run
+
+        struct {
+            Rectangle rec;
+        } rule;
+
+        struct {
+            Vector2 startPos;
+            Vector2 endPos;
+        } line;
+    };
+} RayTeXCommand;
+
+// Flat list of draw commands for a formula whose structure does not change
+// Positions are relative to the top-left of the formula, and the formula can be unloaded once compiled
+typedef struct RayTeXCompiled {
+    RayTeXBox box;
+    int commandCount;
+    RayTeXCommand *commands;     // commandCount commands, drawn in order
+    int glyphCount;
+    RayTeXCompiledGlyph *glyphs; // Glyph runs of every TEXCOMMAND_TEXT (same allocation as commands)
+    int fontCount;
+    Font *fonts;                 // Fonts the commands were recorded with, in order of first use (same allocation as commands)
+} RayTeXCompiled;
+
+RayTeXCompiled CompileRayTeX(Font font, RayTeX tex, int fontSize);
+void UnloadRayTeXCompiled(RayTeXCompiled compiled);
+void DrawRayTeXCompiled(RayTeXCompiled compiled, int x, int y, Color color);
+
+// Lays out many independent formulas across all cores, writing texs[i]'s box to boxes[i] and its display list to compiled[i]
+// Either output may be NULL. Each compiled[i] must be unloaded with UnloadRayTeXCompiled().
+// Formulas are laid out in parallel, unless any of them has shared children below it (added by pointer or interned).
+// Each formula is laid out where it is and keeps its layout, like with LayoutRayTeX().
+void LayoutRayTeXBatch(RayTeX **texs, int count, Font font, int fontSize, RayTeXBox *boxes, RayTeXCompiled *compiled);
+
+// Laid-out formula in a versioned, position-independent binary format that can be drawn straight from a memory-mapped file
+// Stores glyph runs, rules and lines with resolved positions and colors, so loading it needs no parsing, GenRayTeX*() or measuring.
+// Fonts are not stored: pass the font used to export it as fonts[0], followed by any overriding fonts in the order they appear.
+typedef struct RayTeXBlob {
+    const unsigned char *data;
+    int dataSize;
+    int storage; // How data is released by UnloadRayTeXBlob()
+} RayTeXBlob;
+
+unsigned char *ExportRayTeXBlobToMemory(Font font, RayTeX tex, int fontSize, int *dataSize); // Free with MemFree()
+bool ExportRayTeXBlob(Font font, RayTeX tex, int fontSize, const char *fileName);
+RayTeXBlob LoadRayTeXBlob(const char *fileName);                                            // Maps the file, or reads it if mapping fails
+RayTeXBlob LoadRayTeXBlobFromMemory(const unsigned char *data, int dataSize);               // Does not copy - data must outlive the blob
+void UnloadRayTeXBlob(RayTeXBlob blob);
+Vector2 MeasureRayTeXBlob(RayTeXBlob blob);
+void DrawRayTeXBlob(RayTeXBlob blob, const Font *fonts, int fontCount, int x, int y, Color color); // fonts NULL for the default font
+
+// 16 bytes per node - children directly follow their parent, and each node knows where its subtree ends
+typedef struct RayTeXDocumentNode {
+    unsigned int mode : 8;   // TeXMode
+    unsigned int style : 24; // 1-based index into the document's styles, 0 if not overriding anything
+    unsigned int next;       // Index of the next sibling (one past the end of this node's subtree)
+    int a;                   // Space size, symbol, text offset, or child count
+    int b;                   // Text length or matrix column count
+} RayTeXDocumentNode;
+
+typedef struct RayTeXDocumentStyle {
+    bool isOverridingColor;
+    bool isOverridingFontSize;
+    bool isOverridingFont;
+    Color color;
+    int fontSize;
+    Font font;
+} RayTeXDocumentStyle;
+
+// Scratch space for layout and drawing, one per node
+typedef struct RayTeXDocumentState {
+    Vector2 position;
+    float fontSize;
+    unsigned int fontStyle;
+    unsigned int colorStyle;
+} RayTeXDocumentState;
+
+// Alternative storage for large formulas that do not change shape
+// Nodes live in one array in depth-first order, so layout and drawing are sequential sweeps instead of recursive walks
+typedef struct RayTeXDocument {
+    int nodeCount;
+    RayTeXDocumentNode *nodes;   // nodeCount nodes, the root first
+    int styleCount;
+    RayTeXDocumentStyle *styles; // styleCount styles, only for nodes that override something
+    char *text;                  // Null-terminated content of every text node
+    float *extents;              // Scratch column widths and row extents, with room for the largest matrix
+
+    // Layout cache, parallel to nodes
+    RayTeXBox *boxes;
+    Vector2 *offsets;            // Position of each node relative to its parent
+    RayTeXDocumentState *state;
+    const void *layoutFontId;
+    int layoutFontBaseSize;      // With layoutFontGlyphCount, tells a font reloaded at the same address apart
+    int layoutFontGlyphCount;
+    float layoutFontSize;
+    bool isLayoutValid;
+} RayTeXDocument;
+
+RayTeXDocument LoadRayTeXDocument(RayTeX tex);   // Copies the tree, which can be unloaded afterwards
+void UnloadRayTeXDocument(RayTeXDocument document);
+Vector2 MeasureRayTeXDocument(Font font, RayTeXDocument *document, int fontSize);
+void DrawRayTeXDocument(Font font, RayTeXDocument *document, int x, int y, int fontSize, Color color);
+
 #endif
\ No newline at end of file
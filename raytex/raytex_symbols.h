@@ -0,0 +1,1058 @@
+// Generated by tools/gen_raytex_symbols.py - do not edit by hand
+#ifndef RAYTEX_SYMBOLS_H
+#define RAYTEX_SYMBOLS_H
+
+typedef enum {
+    TEXSYMBOL_UNKNOWN = -1, // Returned by RayTeXSymbolFromName() for names that are not symbols
+    TEXSYMBOL_NEQ,                       // \neq U+2260
+    TEXSYMBOL_LEQ,                       // \leq U+2264
+    TEXSYMBOL_GEQ,                       // \geq U+2265
+    TEXSYMBOL_EQUIV,                     // \equiv U+2261
+    TEXSYMBOL_APPROX,                    // \approx U+2248
+    TEXSYMBOL_SIM,                       // \sim U+223C
+    TEXSYMBOL_SIMEQ,                     // \simeq U+2243
+    TEXSYMBOL_CONG,                      // \cong U+2245
+    TEXSYMBOL_PROPTO,                    // \propto U+221D
+    TEXSYMBOL_LL,                        // \ll U+226A
+    TEXSYMBOL_GG,                        // \gg U+226B
+    TEXSYMBOL_SUBSET,                    // \subset U+2282
+    TEXSYMBOL_SUPSET,                    // \supset U+2283
+    TEXSYMBOL_SUBSETEQ,                  // \subseteq U+2286
+    TEXSYMBOL_SUPSETEQ,                  // \supseteq U+2287
+    TEXSYMBOL_IN,                        // \in U+2208
+    TEXSYMBOL_NI,                        // \ni U+220B
+    TEXSYMBOL_NOTIN,                     // \notin U+2209
+    TEXSYMBOL_PERP,                      // \perp U+22A5
+    TEXSYMBOL_PARALLEL,                  // \parallel U+2225
+    TEXSYMBOL_MID,                       // \mid U+2223
+    TEXSYMBOL_PREC,                      // \prec U+227A
+    TEXSYMBOL_SUCC,                      // \succ U+227B
+    TEXSYMBOL_PRECEQ,                    // \preceq U+2AAF
+    TEXSYMBOL_SUCCEQ,                    // \succeq U+2AB0
+    TEXSYMBOL_DOTEQ,                     // \doteq U+2250
+    TEXSYMBOL_MODELS,                    // \models U+22A8
+    TEXSYMBOL_VDASH,                     // \vdash U+22A2
+    TEXSYMBOL_DASHV,                     // \dashv U+22A3
+    TEXSYMBOL_ASYMP,                     // \asymp U+224D
+    TEXSYMBOL_BOWTIE,                    // \bowtie U+22C8
+    TEXSYMBOL_SMILE,                     // \smile U+2323
+    TEXSYMBOL_FROWN,                     // \frown U+2322
+    TEXSYMBOL_LEFTARROW,                 // \leftarrow U+2190
+    TEXSYMBOL_RIGHTARROW,                // \rightarrow U+2192
+    TEXSYMBOL_UPARROW,                   // \uparrow U+2191
+    TEXSYMBOL_DOWNARROW,                 // \downarrow U+2193
+    TEXSYMBOL_LEFTRIGHTARROW,            // \leftrightarrow U+2194
+    TEXSYMBOL_UPDOWNARROW,               // \updownarrow U+2195
+    TEXSYMBOL_DOUBLE_LEFTARROW,          // \Leftarrow U+21D0
+    TEXSYMBOL_DOUBLE_RIGHTARROW,         // \Rightarrow U+21D2
+    TEXSYMBOL_DOUBLE_UPARROW,            // \Uparrow U+21D1
+    TEXSYMBOL_DOUBLE_DOWNARROW,          // \Downarrow U+21D3
+    TEXSYMBOL_DOUBLE_LEFTRIGHTARROW,     // \Leftrightarrow U+21D4
+    TEXSYMBOL_LONGLEFTARROW,             // \longleftarrow U+27F5
+    TEXSYMBOL_LONGRIGHTARROW,            // \longrightarrow U+27F6
+    TEXSYMBOL_LONGLEFTRIGHTARROW,        // \longleftrightarrow U+27F7
+    TEXSYMBOL_DOUBLE_LONGLEFTARROW,      // \Longleftarrow U+27F8
+    TEXSYMBOL_DOUBLE_LONGRIGHTARROW,     // \Longrightarrow U+27F9
+    TEXSYMBOL_DOUBLE_LONGLEFTRIGHTARROW, // \Longleftrightarrow U+27FA
+    TEXSYMBOL_MAPSTO,                    // \mapsto U+21A6
+    TEXSYMBOL_HOOKLEFTARROW,             // \hookleftarrow U+21A9
+    TEXSYMBOL_HOOKRIGHTARROW,            // \hookrightarrow U+21AA
+    TEXSYMBOL_NEARROW,                   // \nearrow U+2197
+    TEXSYMBOL_SEARROW,                   // \searrow U+2198
+    TEXSYMBOL_SWARROW,                   // \swarrow U+2199
+    TEXSYMBOL_NWARROW,                   // \nwarrow U+2196
+    TEXSYMBOL_LEFTHARPOONUP,             // \leftharpoonup U+21BC
+    TEXSYMBOL_RIGHTHARPOONUP,            // \rightharpoonup U+21C0
+    TEXSYMBOL_RIGHTLEFTHARPOONS,         // \rightleftharpoons U+21CC
+    TEXSYMBOL_PM,                        // \pm U+00B1
+    TEXSYMBOL_MP,                        // \mp U+2213
+    TEXSYMBOL_TIMES,                     // \times U+00D7
+    TEXSYMBOL_DIV,                       // \div U+00F7
+    TEXSYMBOL_CDOT,                      // \cdot U+22C5
+    TEXSYMBOL_AST,                       // \ast U+2217
+    TEXSYMBOL_STAR,                      // \star U+22C6
+    TEXSYMBOL_CIRC,                      // \circ U+2218
+    TEXSYMBOL_BULLET,                    // \bullet U+2219
+    TEXSYMBOL_CAP,                       // \cap U+2229
+    TEXSYMBOL_CUP,                       // \cup U+222A
+    TEXSYMBOL_WEDGE,                     // \wedge U+2227
+    TEXSYMBOL_VEE,                       // \vee U+2228
+    TEXSYMBOL_SETMINUS,                  // \setminus U+2216
+    TEXSYMBOL_OPLUS,                     // \oplus U+2295
+    TEXSYMBOL_OMINUS,                    // \ominus U+2296
+    TEXSYMBOL_OTIMES,                    // \otimes U+2297
+    TEXSYMBOL_OSLASH,                    // \oslash U+2298
+    TEXSYMBOL_ODOT,                      // \odot U+2299
+    TEXSYMBOL_UPLUS,                     // \uplus U+228E
+    TEXSYMBOL_SQCAP,                     // \sqcap U+2293
+    TEXSYMBOL_SQCUP,                     // \sqcup U+2294
+    TEXSYMBOL_DIAMOND,                   // \diamond U+22C4
+    TEXSYMBOL_BIGTRIANGLEUP,             // \bigtriangleup U+25B3
+    TEXSYMBOL_BIGTRIANGLEDOWN,           // \bigtriangledown U+25BD
+    TEXSYMBOL_TRIANGLELEFT,              // \triangleleft U+25C1
+    TEXSYMBOL_TRIANGLERIGHT,             // \triangleright U+25B7
+    TEXSYMBOL_WR,                        // \wr U+2240
+    TEXSYMBOL_AMALG,                     // \amalg U+2A3F
+    TEXSYMBOL_DAGGER,                    // \dagger U+2020
+    TEXSYMBOL_DDAGGER,                   // \ddagger U+2021
+    TEXSYMBOL_SUM,                       // \sum U+2211
+    TEXSYMBOL_PROD,                      // \prod U+220F
+    TEXSYMBOL_COPROD,                    // \coprod U+2210
+    TEXSYMBOL_INT,                       // \int U+222B
+    TEXSYMBOL_OINT,                      // \oint U+222E
+    TEXSYMBOL_BIGCAP,                    // \bigcap U+22C2
+    TEXSYMBOL_BIGCUP,                    // \bigcup U+22C3
+    TEXSYMBOL_BIGWEDGE,                  // \bigwedge U+22C0
+    TEXSYMBOL_BIGVEE,                    // \bigvee U+22C1
+    TEXSYMBOL_BIGOPLUS,                  // \bigoplus U+2A01
+    TEXSYMBOL_BIGOTIMES,                 // \bigotimes U+2A02
+    TEXSYMBOL_INFTY,                     // \infty U+221E
+    TEXSYMBOL_PARTIAL,                   // \partial U+2202
+    TEXSYMBOL_NABLA,                     // \nabla U+2207
+    TEXSYMBOL_FORALL,                    // \forall U+2200
+    TEXSYMBOL_EXISTS,                    // \exists U+2203
+    TEXSYMBOL_NEG,                       // \neg U+00AC
+    TEXSYMBOL_EMPTYSET,                  // \emptyset U+2205
+    TEXSYMBOL_ALEPH,                     // \aleph U+2135
+    TEXSYMBOL_HBAR,                      // \hbar U+210F
+    TEXSYMBOL_ELL,                       // \ell U+2113
+    TEXSYMBOL_WP,                        // \wp U+2118
+    TEXSYMBOL_RE,                        // \Re U+211C
+    TEXSYMBOL_IM,                        // \Im U+2111
+    TEXSYMBOL_ANGLE,                     // \angle U+2220
+    TEXSYMBOL_TRIANGLE,                  // \triangle U+25B3
+    TEXSYMBOL_PRIME,                     // \prime U+2032
+    TEXSYMBOL_SURD,                      // \surd U+221A
+    TEXSYMBOL_TOP,                       // \top U+22A4
+    TEXSYMBOL_BOT,                       // \bot U+22A5
+    TEXSYMBOL_LDOTS,                     // \ldots U+2026
+    TEXSYMBOL_CDOTS,                     // \cdots U+22EF
+    TEXSYMBOL_VDOTS,                     // \vdots U+22EE
+    TEXSYMBOL_DDOTS,                     // \ddots U+22F1
+    TEXSYMBOL_BACKSLASH,                 // \backslash U+005C
+    TEXSYMBOL_CLUBSUIT,                  // \clubsuit U+2663
+    TEXSYMBOL_DIAMONDSUIT,               // \diamondsuit U+2662
+    TEXSYMBOL_HEARTSUIT,                 // \heartsuit U+2661
+    TEXSYMBOL_SPADESUIT,                 // \spadesuit U+2660
+    TEXSYMBOL_FLAT,                      // \flat U+266D
+    TEXSYMBOL_NATURAL,                   // \natural U+266E
+    TEXSYMBOL_SHARP,                     // \sharp U+266F
+    TEXSYMBOL_ALPHA,                     // \alpha U+03B1
+    TEXSYMBOL_BETA,                      // \beta U+03B2
+    TEXSYMBOL_GAMMA,                     // \gamma U+03B3
+    TEXSYMBOL_DELTA,                     // \delta U+03B4
+    TEXSYMBOL_EPSILON,                   // \epsilon U+03F5
+    TEXSYMBOL_VAREPSILON,                // \varepsilon U+03B5
+    TEXSYMBOL_ZETA,                      // \zeta U+03B6
+    TEXSYMBOL_ETA,                       // \eta U+03B7
+    TEXSYMBOL_THETA,                     // \theta U+03B8
+    TEXSYMBOL_VARTHETA,                  // \vartheta U+03D1
+    TEXSYMBOL_IOTA,                      // \iota U+03B9
+    TEXSYMBOL_KAPPA,                     // \kappa U+03BA
+    TEXSYMBOL_LAMBDA,                    // \lambda U+03BB
+    TEXSYMBOL_MU,                        // \mu U+03BC
+    TEXSYMBOL_NU,                        // \nu U+03BD
+    TEXSYMBOL_XI,                        // \xi U+03BE
+    TEXSYMBOL_PI,                        // \pi U+03C0
+    TEXSYMBOL_VARPI,                     // \varpi U+03D6
+    TEXSYMBOL_RHO,                       // \rho U+03C1
+    TEXSYMBOL_VARRHO,                    // \varrho U+03F1
+    TEXSYMBOL_SIGMA,                     // \sigma U+03C3
+    TEXSYMBOL_VARSIGMA,                  // \varsigma U+03C2
+    TEXSYMBOL_TAU,                       // \tau U+03C4
+    TEXSYMBOL_UPSILON,                   // \upsilon U+03C5
+    TEXSYMBOL_PHI,                       // \phi U+03D5
+    TEXSYMBOL_VARPHI,                    // \varphi U+03C6
+    TEXSYMBOL_CHI,                       // \chi U+03C7
+    TEXSYMBOL_PSI,                       // \psi U+03C8
+    TEXSYMBOL_OMEGA,                     // \omega U+03C9
+    TEXSYMBOL_CAPITAL_GAMMA,             // \Gamma U+0393
+    TEXSYMBOL_CAPITAL_DELTA,             // \Delta U+0394
+    TEXSYMBOL_CAPITAL_THETA,             // \Theta U+0398
+    TEXSYMBOL_CAPITAL_LAMBDA,            // \Lambda U+039B
+    TEXSYMBOL_CAPITAL_XI,                // \Xi U+039E
+    TEXSYMBOL_CAPITAL_PI,                // \Pi U+03A0
+    TEXSYMBOL_CAPITAL_SIGMA,             // \Sigma U+03A3
+    TEXSYMBOL_CAPITAL_UPSILON,           // \Upsilon U+03A5
+    TEXSYMBOL_CAPITAL_PHI,               // \Phi U+03A6
+    TEXSYMBOL_CAPITAL_PSI,               // \Psi U+03A8
+    TEXSYMBOL_CAPITAL_OMEGA,             // \Omega U+03A9
+    TEXSYMBOL_COUNT,
+} RayTeXSymbol;
+
+#endif
+
+#if defined(RAYTEX_SYMBOLS_IMPLEMENTATION) && !defined(RAYTEX_SYMBOLS_IMPLEMENTATION_DEFINED)
+#define RAYTEX_SYMBOLS_IMPLEMENTATION_DEFINED
+
+enum {
+    TEXSYMBOLCLASS_ORD,
+    TEXSYMBOLCLASS_OP,
+    TEXSYMBOLCLASS_BIN,
+    TEXSYMBOLCLASS_REL,
+};
+
+static const int symbolCodepoints[TEXSYMBOL_COUNT] = {
+    0x2260, // TEXSYMBOL_NEQ
+    0x2264, // TEXSYMBOL_LEQ
+    0x2265, // TEXSYMBOL_GEQ
+    0x2261, // TEXSYMBOL_EQUIV
+    0x2248, // TEXSYMBOL_APPROX
+    0x223C, // TEXSYMBOL_SIM
+    0x2243, // TEXSYMBOL_SIMEQ
+    0x2245, // TEXSYMBOL_CONG
+    0x221D, // TEXSYMBOL_PROPTO
+    0x226A, // TEXSYMBOL_LL
+    0x226B, // TEXSYMBOL_GG
+    0x2282, // TEXSYMBOL_SUBSET
+    0x2283, // TEXSYMBOL_SUPSET
+    0x2286, // TEXSYMBOL_SUBSETEQ
+    0x2287, // TEXSYMBOL_SUPSETEQ
+    0x2208, // TEXSYMBOL_IN
+    0x220B, // TEXSYMBOL_NI
+    0x2209, // TEXSYMBOL_NOTIN
+    0x22A5, // TEXSYMBOL_PERP
+    0x2225, // TEXSYMBOL_PARALLEL
+    0x2223, // TEXSYMBOL_MID
+    0x227A, // TEXSYMBOL_PREC
+    0x227B, // TEXSYMBOL_SUCC
+    0x2AAF, // TEXSYMBOL_PRECEQ
+    0x2AB0, // TEXSYMBOL_SUCCEQ
+    0x2250, // TEXSYMBOL_DOTEQ
+    0x22A8, // TEXSYMBOL_MODELS
+    0x22A2, // TEXSYMBOL_VDASH
+    0x22A3, // TEXSYMBOL_DASHV
+    0x224D, // TEXSYMBOL_ASYMP
+    0x22C8, // TEXSYMBOL_BOWTIE
+    0x2323, // TEXSYMBOL_SMILE
+    0x2322, // TEXSYMBOL_FROWN
+    0x2190, // TEXSYMBOL_LEFTARROW
+    0x2192, // TEXSYMBOL_RIGHTARROW
+    0x2191, // TEXSYMBOL_UPARROW
+    0x2193, // TEXSYMBOL_DOWNARROW
+    0x2194, // TEXSYMBOL_LEFTRIGHTARROW
+    0x2195, // TEXSYMBOL_UPDOWNARROW
+    0x21D0, // TEXSYMBOL_DOUBLE_LEFTARROW
+    0x21D2, // TEXSYMBOL_DOUBLE_RIGHTARROW
+    0x21D1, // TEXSYMBOL_DOUBLE_UPARROW
+    0x21D3, // TEXSYMBOL_DOUBLE_DOWNARROW
+    0x21D4, // TEXSYMBOL_DOUBLE_LEFTRIGHTARROW
+    0x27F5, // TEXSYMBOL_LONGLEFTARROW
+    0x27F6, // TEXSYMBOL_LONGRIGHTARROW
+    0x27F7, // TEXSYMBOL_LONGLEFTRIGHTARROW
+    0x27F8, // TEXSYMBOL_DOUBLE_LONGLEFTARROW
+    0x27F9, // TEXSYMBOL_DOUBLE_LONGRIGHTARROW
+    0x27FA, // TEXSYMBOL_DOUBLE_LONGLEFTRIGHTARROW
+    0x21A6, // TEXSYMBOL_MAPSTO
+    0x21A9, // TEXSYMBOL_HOOKLEFTARROW
+    0x21AA, // TEXSYMBOL_HOOKRIGHTARROW
+    0x2197, // TEXSYMBOL_NEARROW
+    0x2198, // TEXSYMBOL_SEARROW
+    0x2199, // TEXSYMBOL_SWARROW
+    0x2196, // TEXSYMBOL_NWARROW
+    0x21BC, // TEXSYMBOL_LEFTHARPOONUP
+    0x21C0, // TEXSYMBOL_RIGHTHARPOONUP
+    0x21CC, // TEXSYMBOL_RIGHTLEFTHARPOONS
+    0x00B1, // TEXSYMBOL_PM
+    0x2213, // TEXSYMBOL_MP
+    0x00D7, // TEXSYMBOL_TIMES
+    0x00F7, // TEXSYMBOL_DIV
+    0x22C5, // TEXSYMBOL_CDOT
+    0x2217, // TEXSYMBOL_AST
+    0x22C6, // TEXSYMBOL_STAR
+    0x2218, // TEXSYMBOL_CIRC
+    0x2219, // TEXSYMBOL_BULLET
+    0x2229, // TEXSYMBOL_CAP
+    0x222A, // TEXSYMBOL_CUP
+    0x2227, // TEXSYMBOL_WEDGE
+    0x2228, // TEXSYMBOL_VEE
+    0x2216, // TEXSYMBOL_SETMINUS
+    0x2295, // TEXSYMBOL_OPLUS
+    0x2296, // TEXSYMBOL_OMINUS
+    0x2297, // TEXSYMBOL_OTIMES
+    0x2298, // TEXSYMBOL_OSLASH
+    0x2299, // TEXSYMBOL_ODOT
+    0x228E, // TEXSYMBOL_UPLUS
+    0x2293, // TEXSYMBOL_SQCAP
+    0x2294, // TEXSYMBOL_SQCUP
+    0x22C4, // TEXSYMBOL_DIAMOND
+    0x25B3, // TEXSYMBOL_BIGTRIANGLEUP
+    0x25BD, // TEXSYMBOL_BIGTRIANGLEDOWN
+    0x25C1, // TEXSYMBOL_TRIANGLELEFT
+    0x25B7, // TEXSYMBOL_TRIANGLERIGHT
+    0x2240, // TEXSYMBOL_WR
+    0x2A3F, // TEXSYMBOL_AMALG
+    0x2020, // TEXSYMBOL_DAGGER
+    0x2021, // TEXSYMBOL_DDAGGER
+    0x2211, // TEXSYMBOL_SUM
+    0x220F, // TEXSYMBOL_PROD
+    0x2210, // TEXSYMBOL_COPROD
+    0x222B, // TEXSYMBOL_INT
+    0x222E, // TEXSYMBOL_OINT
+    0x22C2, // TEXSYMBOL_BIGCAP
+    0x22C3, // TEXSYMBOL_BIGCUP
+    0x22C0, // TEXSYMBOL_BIGWEDGE
+    0x22C1, // TEXSYMBOL_BIGVEE
+    0x2A01, // TEXSYMBOL_BIGOPLUS
+    0x2A02, // TEXSYMBOL_BIGOTIMES
+    0x221E, // TEXSYMBOL_INFTY
+    0x2202, // TEXSYMBOL_PARTIAL
+    0x2207, // TEXSYMBOL_NABLA
+    0x2200, // TEXSYMBOL_FORALL
+    0x2203, // TEXSYMBOL_EXISTS
+    0x00AC, // TEXSYMBOL_NEG
+    0x2205, // TEXSYMBOL_EMPTYSET
+    0x2135, // TEXSYMBOL_ALEPH
+    0x210F, // TEXSYMBOL_HBAR
+    0x2113, // TEXSYMBOL_ELL
+    0x2118, // TEXSYMBOL_WP
+    0x211C, // TEXSYMBOL_RE
+    0x2111, // TEXSYMBOL_IM
+    0x2220, // TEXSYMBOL_ANGLE
+    0x25B3, // TEXSYMBOL_TRIANGLE
+    0x2032, // TEXSYMBOL_PRIME
+    0x221A, // TEXSYMBOL_SURD
+    0x22A4, // TEXSYMBOL_TOP
+    0x22A5, // TEXSYMBOL_BOT
+    0x2026, // TEXSYMBOL_LDOTS
+    0x22EF, // TEXSYMBOL_CDOTS
+    0x22EE, // TEXSYMBOL_VDOTS
+    0x22F1, // TEXSYMBOL_DDOTS
+    0x005C, // TEXSYMBOL_BACKSLASH
+    0x2663, // TEXSYMBOL_CLUBSUIT
+    0x2662, // TEXSYMBOL_DIAMONDSUIT
+    0x2661, // TEXSYMBOL_HEARTSUIT
+    0x2660, // TEXSYMBOL_SPADESUIT
+    0x266D, // TEXSYMBOL_FLAT
+    0x266E, // TEXSYMBOL_NATURAL
+    0x266F, // TEXSYMBOL_SHARP
+    0x03B1, // TEXSYMBOL_ALPHA
+    0x03B2, // TEXSYMBOL_BETA
+    0x03B3, // TEXSYMBOL_GAMMA
+    0x03B4, // TEXSYMBOL_DELTA
+    0x03F5, // TEXSYMBOL_EPSILON
+    0x03B5, // TEXSYMBOL_VAREPSILON
+    0x03B6, // TEXSYMBOL_ZETA
+    0x03B7, // TEXSYMBOL_ETA
+    0x03B8, // TEXSYMBOL_THETA
+    0x03D1, // TEXSYMBOL_VARTHETA
+    0x03B9, // TEXSYMBOL_IOTA
+    0x03BA, // TEXSYMBOL_KAPPA
+    0x03BB, // TEXSYMBOL_LAMBDA
+    0x03BC, // TEXSYMBOL_MU
+    0x03BD, // TEXSYMBOL_NU
+    0x03BE, // TEXSYMBOL_XI
+    0x03C0, // TEXSYMBOL_PI
+    0x03D6, // TEXSYMBOL_VARPI
+    0x03C1, // TEXSYMBOL_RHO
+    0x03F1, // TEXSYMBOL_VARRHO
+    0x03C3, // TEXSYMBOL_SIGMA
+    0x03C2, // TEXSYMBOL_VARSIGMA
+    0x03C4, // TEXSYMBOL_TAU
+    0x03C5, // TEXSYMBOL_UPSILON
+    0x03D5, // TEXSYMBOL_PHI
+    0x03C6, // TEXSYMBOL_VARPHI
+    0x03C7, // TEXSYMBOL_CHI
+    0x03C8, // TEXSYMBOL_PSI
+    0x03C9, // TEXSYMBOL_OMEGA
+    0x0393, // TEXSYMBOL_CAPITAL_GAMMA
+    0x0394, // TEXSYMBOL_CAPITAL_DELTA
+    0x0398, // TEXSYMBOL_CAPITAL_THETA
+    0x039B, // TEXSYMBOL_CAPITAL_LAMBDA
+    0x039E, // TEXSYMBOL_CAPITAL_XI
+    0x03A0, // TEXSYMBOL_CAPITAL_PI
+    0x03A3, // TEXSYMBOL_CAPITAL_SIGMA
+    0x03A5, // TEXSYMBOL_CAPITAL_UPSILON
+    0x03A6, // TEXSYMBOL_CAPITAL_PHI
+    0x03A8, // TEXSYMBOL_CAPITAL_PSI
+    0x03A9, // TEXSYMBOL_CAPITAL_OMEGA
+};
+
+static const unsigned char symbolClasses[TEXSYMBOL_COUNT] = {
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_NEQ
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_LEQ
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_GEQ
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_EQUIV
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_APPROX
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_SIM
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_SIMEQ
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_CONG
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_PROPTO
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_LL
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_GG
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_SUBSET
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_SUPSET
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_SUBSETEQ
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_SUPSETEQ
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_IN
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_NI
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_NOTIN
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_PERP
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_PARALLEL
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_MID
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_PREC
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_SUCC
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_PRECEQ
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_SUCCEQ
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_DOTEQ
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_MODELS
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_VDASH
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_DASHV
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_ASYMP
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_BOWTIE
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_SMILE
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_FROWN
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_LEFTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_RIGHTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_UPARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_DOWNARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_LEFTRIGHTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_UPDOWNARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_DOUBLE_LEFTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_DOUBLE_RIGHTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_DOUBLE_UPARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_DOUBLE_DOWNARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_DOUBLE_LEFTRIGHTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_LONGLEFTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_LONGRIGHTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_LONGLEFTRIGHTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_DOUBLE_LONGLEFTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_DOUBLE_LONGRIGHTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_DOUBLE_LONGLEFTRIGHTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_MAPSTO
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_HOOKLEFTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_HOOKRIGHTARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_NEARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_SEARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_SWARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_NWARROW
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_LEFTHARPOONUP
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_RIGHTHARPOONUP
+    TEXSYMBOLCLASS_REL, // TEXSYMBOL_RIGHTLEFTHARPOONS
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_PM
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_MP
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_TIMES
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_DIV
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_CDOT
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_AST
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_STAR
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_CIRC
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_BULLET
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_CAP
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_CUP
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_WEDGE
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_VEE
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_SETMINUS
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_OPLUS
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_OMINUS
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_OTIMES
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_OSLASH
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_ODOT
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_UPLUS
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_SQCAP
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_SQCUP
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_DIAMOND
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_BIGTRIANGLEUP
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_BIGTRIANGLEDOWN
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_TRIANGLELEFT
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_TRIANGLERIGHT
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_WR
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_AMALG
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_DAGGER
+    TEXSYMBOLCLASS_BIN, // TEXSYMBOL_DDAGGER
+    TEXSYMBOLCLASS_OP, // TEXSYMBOL_SUM
+    TEXSYMBOLCLASS_OP, // TEXSYMBOL_PROD
+    TEXSYMBOLCLASS_OP, // TEXSYMBOL_COPROD
+    TEXSYMBOLCLASS_OP, // TEXSYMBOL_INT
+    TEXSYMBOLCLASS_OP, // TEXSYMBOL_OINT
+    TEXSYMBOLCLASS_OP, // TEXSYMBOL_BIGCAP
+    TEXSYMBOLCLASS_OP, // TEXSYMBOL_BIGCUP
+    TEXSYMBOLCLASS_OP, // TEXSYMBOL_BIGWEDGE
+    TEXSYMBOLCLASS_OP, // TEXSYMBOL_BIGVEE
+    TEXSYMBOLCLASS_OP, // TEXSYMBOL_BIGOPLUS
+    TEXSYMBOLCLASS_OP, // TEXSYMBOL_BIGOTIMES
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_INFTY
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_PARTIAL
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_NABLA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_FORALL
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_EXISTS
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_NEG
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_EMPTYSET
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_ALEPH
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_HBAR
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_ELL
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_WP
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_RE
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_IM
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_ANGLE
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_TRIANGLE
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_PRIME
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_SURD
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_TOP
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_BOT
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_LDOTS
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CDOTS
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_VDOTS
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_DDOTS
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_BACKSLASH
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CLUBSUIT
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_DIAMONDSUIT
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_HEARTSUIT
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_SPADESUIT
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_FLAT
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_NATURAL
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_SHARP
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_ALPHA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_BETA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_GAMMA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_DELTA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_EPSILON
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_VAREPSILON
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_ZETA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_ETA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_THETA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_VARTHETA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_IOTA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_KAPPA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_LAMBDA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_MU
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_NU
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_XI
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_PI
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_VARPI
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_RHO
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_VARRHO
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_SIGMA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_VARSIGMA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_TAU
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_UPSILON
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_PHI
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_VARPHI
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CHI
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_PSI
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_OMEGA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CAPITAL_GAMMA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CAPITAL_DELTA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CAPITAL_THETA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CAPITAL_LAMBDA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CAPITAL_XI
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CAPITAL_PI
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CAPITAL_SIGMA
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CAPITAL_UPSILON
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CAPITAL_PHI
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CAPITAL_PSI
+    TEXSYMBOLCLASS_ORD, // TEXSYMBOL_CAPITAL_OMEGA
+};
+
+#define SYMBOL_NAME_COUNT 184
+
+static const char *const symbolNames[SYMBOL_NAME_COUNT] = {
+    "neq",
+    "leq",
+    "geq",
+    "equiv",
+    "approx",
+    "sim",
+    "simeq",
+    "cong",
+    "propto",
+    "ll",
+    "gg",
+    "subset",
+    "supset",
+    "subseteq",
+    "supseteq",
+    "in",
+    "ni",
+    "notin",
+    "perp",
+    "parallel",
+    "mid",
+    "prec",
+    "succ",
+    "preceq",
+    "succeq",
+    "doteq",
+    "models",
+    "vdash",
+    "dashv",
+    "asymp",
+    "bowtie",
+    "smile",
+    "frown",
+    "leftarrow",
+    "rightarrow",
+    "uparrow",
+    "downarrow",
+    "leftrightarrow",
+    "updownarrow",
+    "Leftarrow",
+    "Rightarrow",
+    "Uparrow",
+    "Downarrow",
+    "Leftrightarrow",
+    "longleftarrow",
+    "longrightarrow",
+    "longleftrightarrow",
+    "Longleftarrow",
+    "Longrightarrow",
+    "Longleftrightarrow",
+    "mapsto",
+    "hookleftarrow",
+    "hookrightarrow",
+    "nearrow",
+    "searrow",
+    "swarrow",
+    "nwarrow",
+    "leftharpoonup",
+    "rightharpoonup",
+    "rightleftharpoons",
+    "pm",
+    "mp",
+    "times",
+    "div",
+    "cdot",
+    "ast",
+    "star",
+    "circ",
+    "bullet",
+    "cap",
+    "cup",
+    "wedge",
+    "vee",
+    "setminus",
+    "oplus",
+    "ominus",
+    "otimes",
+    "oslash",
+    "odot",
+    "uplus",
+    "sqcap",
+    "sqcup",
+    "diamond",
+    "bigtriangleup",
+    "bigtriangledown",
+    "triangleleft",
+    "triangleright",
+    "wr",
+    "amalg",
+    "dagger",
+    "ddagger",
+    "sum",
+    "prod",
+    "coprod",
+    "int",
+    "oint",
+    "bigcap",
+    "bigcup",
+    "bigwedge",
+    "bigvee",
+    "bigoplus",
+    "bigotimes",
+    "infty",
+    "partial",
+    "nabla",
+    "forall",
+    "exists",
+    "neg",
+    "emptyset",
+    "aleph",
+    "hbar",
+    "ell",
+    "wp",
+    "Re",
+    "Im",
+    "angle",
+    "triangle",
+    "prime",
+    "surd",
+    "top",
+    "bot",
+    "ldots",
+    "cdots",
+    "vdots",
+    "ddots",
+    "backslash",
+    "clubsuit",
+    "diamondsuit",
+    "heartsuit",
+    "spadesuit",
+    "flat",
+    "natural",
+    "sharp",
+    "alpha",
+    "beta",
+    "gamma",
+    "delta",
+    "epsilon",
+    "varepsilon",
+    "zeta",
+    "eta",
+    "theta",
+    "vartheta",
+    "iota",
+    "kappa",
+    "lambda",
+    "mu",
+    "nu",
+    "xi",
+    "pi",
+    "varpi",
+    "rho",
+    "varrho",
+    "sigma",
+    "varsigma",
+    "tau",
+    "upsilon",
+    "phi",
+    "varphi",
+    "chi",
+    "psi",
+    "omega",
+    "Gamma",
+    "Delta",
+    "Theta",
+    "Lambda",
+    "Xi",
+    "Pi",
+    "Sigma",
+    "Upsilon",
+    "Phi",
+    "Psi",
+    "Omega",
+    "ne",
+    "le",
+    "ge",
+    "gets",
+    "to",
+    "owns",
+    "land",
+    "lor",
+    "lnot",
+    "implies",
+    "iff",
+};
+
+static const RayTeXSymbol symbolNameValues[SYMBOL_NAME_COUNT] = {
+    TEXSYMBOL_NEQ, // neq
+    TEXSYMBOL_LEQ, // leq
+    TEXSYMBOL_GEQ, // geq
+    TEXSYMBOL_EQUIV, // equiv
+    TEXSYMBOL_APPROX, // approx
+    TEXSYMBOL_SIM, // sim
+    TEXSYMBOL_SIMEQ, // simeq
+    TEXSYMBOL_CONG, // cong
+    TEXSYMBOL_PROPTO, // propto
+    TEXSYMBOL_LL, // ll
+    TEXSYMBOL_GG, // gg
+    TEXSYMBOL_SUBSET, // subset
+    TEXSYMBOL_SUPSET, // supset
+    TEXSYMBOL_SUBSETEQ, // subseteq
+    TEXSYMBOL_SUPSETEQ, // supseteq
+    TEXSYMBOL_IN, // in
+    TEXSYMBOL_NI, // ni
+    TEXSYMBOL_NOTIN, // notin
+    TEXSYMBOL_PERP, // perp
+    TEXSYMBOL_PARALLEL, // parallel
+    TEXSYMBOL_MID, // mid
+    TEXSYMBOL_PREC, // prec
+    TEXSYMBOL_SUCC, // succ
+    TEXSYMBOL_PRECEQ, // preceq
+    TEXSYMBOL_SUCCEQ, // succeq
+    TEXSYMBOL_DOTEQ, // doteq
+    TEXSYMBOL_MODELS, // models
+    TEXSYMBOL_VDASH, // vdash
+    TEXSYMBOL_DASHV, // dashv
+    TEXSYMBOL_ASYMP, // asymp
+    TEXSYMBOL_BOWTIE, // bowtie
+    TEXSYMBOL_SMILE, // smile
+    TEXSYMBOL_FROWN, // frown
+    TEXSYMBOL_LEFTARROW, // leftarrow
+    TEXSYMBOL_RIGHTARROW, // rightarrow
+    TEXSYMBOL_UPARROW, // uparrow
+    TEXSYMBOL_DOWNARROW, // downarrow
+    TEXSYMBOL_LEFTRIGHTARROW, // leftrightarrow
+    TEXSYMBOL_UPDOWNARROW, // updownarrow
+    TEXSYMBOL_DOUBLE_LEFTARROW, // Leftarrow
+    TEXSYMBOL_DOUBLE_RIGHTARROW, // Rightarrow
+    TEXSYMBOL_DOUBLE_UPARROW, // Uparrow
+    TEXSYMBOL_DOUBLE_DOWNARROW, // Downarrow
+    TEXSYMBOL_DOUBLE_LEFTRIGHTARROW, // Leftrightarrow
+    TEXSYMBOL_LONGLEFTARROW, // longleftarrow
+    TEXSYMBOL_LONGRIGHTARROW, // longrightarrow
+    TEXSYMBOL_LONGLEFTRIGHTARROW, // longleftrightarrow
+    TEXSYMBOL_DOUBLE_LONGLEFTARROW, // Longleftarrow
+    TEXSYMBOL_DOUBLE_LONGRIGHTARROW, // Longrightarrow
+    TEXSYMBOL_DOUBLE_LONGLEFTRIGHTARROW, // Longleftrightarrow
+    TEXSYMBOL_MAPSTO, // mapsto
+    TEXSYMBOL_HOOKLEFTARROW, // hookleftarrow
+    TEXSYMBOL_HOOKRIGHTARROW, // hookrightarrow
+    TEXSYMBOL_NEARROW, // nearrow
+    TEXSYMBOL_SEARROW, // searrow
+    TEXSYMBOL_SWARROW, // swarrow
+    TEXSYMBOL_NWARROW, // nwarrow
+    TEXSYMBOL_LEFTHARPOONUP, // leftharpoonup
+    TEXSYMBOL_RIGHTHARPOONUP, // rightharpoonup
+    TEXSYMBOL_RIGHTLEFTHARPOONS, // rightleftharpoons
+    TEXSYMBOL_PM, // pm
+    TEXSYMBOL_MP, // mp
+    TEXSYMBOL_TIMES, // times
+    TEXSYMBOL_DIV, // div
+    TEXSYMBOL_CDOT, // cdot
+    TEXSYMBOL_AST, // ast
+    TEXSYMBOL_STAR, // star
+    TEXSYMBOL_CIRC, // circ
+    TEXSYMBOL_BULLET, // bullet
+    TEXSYMBOL_CAP, // cap
+    TEXSYMBOL_CUP, // cup
+    TEXSYMBOL_WEDGE, // wedge
+    TEXSYMBOL_VEE, // vee
+    TEXSYMBOL_SETMINUS, // setminus
+    TEXSYMBOL_OPLUS, // oplus
+    TEXSYMBOL_OMINUS, // ominus
+    TEXSYMBOL_OTIMES, // otimes
+    TEXSYMBOL_OSLASH, // oslash
+    TEXSYMBOL_ODOT, // odot
+    TEXSYMBOL_UPLUS, // uplus
+    TEXSYMBOL_SQCAP, // sqcap
+    TEXSYMBOL_SQCUP, // sqcup
+    TEXSYMBOL_DIAMOND, // diamond
+    TEXSYMBOL_BIGTRIANGLEUP, // bigtriangleup
+    TEXSYMBOL_BIGTRIANGLEDOWN, // bigtriangledown
+    TEXSYMBOL_TRIANGLELEFT, // triangleleft
+    TEXSYMBOL_TRIANGLERIGHT, // triangleright
+    TEXSYMBOL_WR, // wr
+    TEXSYMBOL_AMALG, // amalg
+    TEXSYMBOL_DAGGER, // dagger
+    TEXSYMBOL_DDAGGER, // ddagger
+    TEXSYMBOL_SUM, // sum
+    TEXSYMBOL_PROD, // prod
+    TEXSYMBOL_COPROD, // coprod
+    TEXSYMBOL_INT, // int
+    TEXSYMBOL_OINT, // oint
+    TEXSYMBOL_BIGCAP, // bigcap
+    TEXSYMBOL_BIGCUP, // bigcup
+    TEXSYMBOL_BIGWEDGE, // bigwedge
+    TEXSYMBOL_BIGVEE, // bigvee
+    TEXSYMBOL_BIGOPLUS, // bigoplus
+    TEXSYMBOL_BIGOTIMES, // bigotimes
+    TEXSYMBOL_INFTY, // infty
+    TEXSYMBOL_PARTIAL, // partial
+    TEXSYMBOL_NABLA, // nabla
+    TEXSYMBOL_FORALL, // forall
+    TEXSYMBOL_EXISTS, // exists
+    TEXSYMBOL_NEG, // neg
+    TEXSYMBOL_EMPTYSET, // emptyset
+    TEXSYMBOL_ALEPH, // aleph
+    TEXSYMBOL_HBAR, // hbar
+    TEXSYMBOL_ELL, // ell
+    TEXSYMBOL_WP, // wp
+    TEXSYMBOL_RE, // Re
+    TEXSYMBOL_IM, // Im
+    TEXSYMBOL_ANGLE, // angle
+    TEXSYMBOL_TRIANGLE, // triangle
+    TEXSYMBOL_PRIME, // prime
+    TEXSYMBOL_SURD, // surd
+    TEXSYMBOL_TOP, // top
+    TEXSYMBOL_BOT, // bot
+    TEXSYMBOL_LDOTS, // ldots
+    TEXSYMBOL_CDOTS, // cdots
+    TEXSYMBOL_VDOTS, // vdots
+    TEXSYMBOL_DDOTS, // ddots
+    TEXSYMBOL_BACKSLASH, // backslash
+    TEXSYMBOL_CLUBSUIT, // clubsuit
+    TEXSYMBOL_DIAMONDSUIT, // diamondsuit
+    TEXSYMBOL_HEARTSUIT, // heartsuit
+    TEXSYMBOL_SPADESUIT, // spadesuit
+    TEXSYMBOL_FLAT, // flat
+    TEXSYMBOL_NATURAL, // natural
+    TEXSYMBOL_SHARP, // sharp
+    TEXSYMBOL_ALPHA, // alpha
+    TEXSYMBOL_BETA, // beta
+    TEXSYMBOL_GAMMA, // gamma
+    TEXSYMBOL_DELTA, // delta
+    TEXSYMBOL_EPSILON, // epsilon
+    TEXSYMBOL_VAREPSILON, // varepsilon
+    TEXSYMBOL_ZETA, // zeta
+    TEXSYMBOL_ETA, // eta
+    TEXSYMBOL_THETA, // theta
+    TEXSYMBOL_VARTHETA, // vartheta
+    TEXSYMBOL_IOTA, // iota
+    TEXSYMBOL_KAPPA, // kappa
+    TEXSYMBOL_LAMBDA, // lambda
+    TEXSYMBOL_MU, // mu
+    TEXSYMBOL_NU, // nu
+    TEXSYMBOL_XI, // xi
+    TEXSYMBOL_PI, // pi
+    TEXSYMBOL_VARPI, // varpi
+    TEXSYMBOL_RHO, // rho
+    TEXSYMBOL_VARRHO, // varrho
+    TEXSYMBOL_SIGMA, // sigma
+    TEXSYMBOL_VARSIGMA, // varsigma
+    TEXSYMBOL_TAU, // tau
+    TEXSYMBOL_UPSILON, // upsilon
+    TEXSYMBOL_PHI, // phi
+    TEXSYMBOL_VARPHI, // varphi
+    TEXSYMBOL_CHI, // chi
+    TEXSYMBOL_PSI, // psi
+    TEXSYMBOL_OMEGA, // omega
+    TEXSYMBOL_CAPITAL_GAMMA, // Gamma
+    TEXSYMBOL_CAPITAL_DELTA, // Delta
+    TEXSYMBOL_CAPITAL_THETA, // Theta
+    TEXSYMBOL_CAPITAL_LAMBDA, // Lambda
+    TEXSYMBOL_CAPITAL_XI, // Xi
+    TEXSYMBOL_CAPITAL_PI, // Pi
+    TEXSYMBOL_CAPITAL_SIGMA, // Sigma
+    TEXSYMBOL_CAPITAL_UPSILON, // Upsilon
+    TEXSYMBOL_CAPITAL_PHI, // Phi
+    TEXSYMBOL_CAPITAL_PSI, // Psi
+    TEXSYMBOL_CAPITAL_OMEGA, // Omega
+    TEXSYMBOL_NEQ, // ne
+    TEXSYMBOL_LEQ, // le
+    TEXSYMBOL_GEQ, // ge
+    TEXSYMBOL_LEFTARROW, // gets
+    TEXSYMBOL_RIGHTARROW, // to
+    TEXSYMBOL_NI, // owns
+    TEXSYMBOL_WEDGE, // land
+    TEXSYMBOL_VEE, // lor
+    TEXSYMBOL_NEG, // lnot
+    TEXSYMBOL_DOUBLE_LONGRIGHTARROW, // implies
+    TEXSYMBOL_DOUBLE_LONGLEFTRIGHTARROW, // iff
+};
+
+// Perfect hash: every name lands in its own slot, which holds its index in symbolNames plus one
+#define SYMBOL_HASH_SEED 886u
+#define SYMBOL_HASH_TABLE_SIZE 2048
+
+static const unsigned short symbolHashSlots[SYMBOL_HASH_TABLE_SIZE] = {
+    160,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  15,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  96,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,  37,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 150, 109, 179, 134,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  63,   3,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 173,   0,   0,   0,
+    126,   0,   0,   0,   0, 177,   0,   0,  27,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+     49,   0,   0,  40,   0,   0,  35,   0,   0,   0,   0, 163,   0,   0,   0,   0,
+      0,   0,  32,   0,   0,   0,   0,   0,   0, 118,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,  11,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0, 112,   0,   0,   0, 143,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 184,   0,   0,   0,   0,
+    116,   0,   0,   0,   0,   0,  94,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,  30,   0,   0,   0, 122,  77,   0,   0,   0,   0,   0,   0, 115,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,  73,   0,   0,   0,   0,   0,   0, 125,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   9,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+     83,   0,   0,   0,   0,   0,   0,   0,   0,   0, 111,   0,   0,   0,   0,   0,
+      0,   0,  39,   0,   0,   0,   0,  53,   0, 181,   0,  58,   0,   0,   0,   0,
+      0,   0,   0, 141,  25,   0,   0,   0,   0,   0,   0,   0,   0, 176,   0,   8,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 117,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0, 170,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0, 146,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,  14,   0,  75,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    106,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,  95,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0, 131,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  51,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 169,  29,   0, 165,   0,
+      0,   0,   0,   0,  67,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   0,
+     85,   0,  74,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 153,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  33,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  70,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0, 142,   0, 120,   0,   0,   0,   0,   0,   0,   0,   0,  82,   0,
+      0,   0, 100, 145,   0,   0,   0,   0,  26,   0,  52,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 102,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0, 135,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  79,   0,   0,   0,   0,
+    105,   0,   0,   0,   0,   0,   0,   0,   0,  71,   0,   0,   0,   0,   0,  19,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  43,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 113,   0,   0,   0,   0,
+      0,   0,   0, 164,   0,   0,   0,   0,   0,   0,   0, 144,   0,   0,   0,   0,
+      0,   0,   0,  55,  24,   0,   0,   0,   0,   0,   0, 110, 151,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0, 152,   0,   0, 158,   0,   0,   0,   0,   0,
+    127,   0,   0,   0,   0, 130,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,  54,   0,   0,   0,   0,   0,   0,
+      0,   0,   0, 147,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,  12,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0, 108,   0,   0,   0,   0,   0,   0,
+     92,   0,   0,   0,   0,  16,   0,   0,   0,  65,   0,   5,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0, 104,   0,   0,   0,   0, 148,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 139,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,  20,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 182,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0, 114,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    101,   0,   0,   0,   0,   0,   0,   0,   0,   0,  41,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 174,   0,  66,
+     31,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,  38,  18,   0,   0,   0,   0, 155,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 138,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,  46,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 137,
+     56,   0,   0,   0,  34,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,  97,   0,   0,   0,   0,   0,   0,   0,   0,  21,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,  98,   0,   0,   0,   0,   0,   0,   0,   0,  80,   0,  44,   0,   0,   0,
+      0,   0,   0,   0,   0,   0, 166,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  50,   0, 157,   0,   0,   0,
+      0,   0,   0, 103,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0, 171,   0,   0,   0,   0,   0,   0, 156,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0, 129, 175,   0,   0,  57,   0,   0,   0,
+      0,   0,   0,  89,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,  17,   0,   0,   0,   0,   0,   0,  76,   0,   0,   0,   0,   0,   0,   0,
+      0, 128,   0,   0,   0,   0,   0,   0,   6,   0,   7,  59,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,  81,   0,   0, 162,  36,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  28,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,  61,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,  88,  90, 140,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,  72,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    107,   0,   0,   0, 124,   0,   0,   0, 149, 121,   0,   0,  99,   0,   0,   0,
+      0, 159,   0,   0,   0,   0, 161, 133,  60,   0, 123,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,  64,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+     62,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  23,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 172,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 119,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   2,
+      0,  68,   0,   0,   0,   0,  48,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,  47,   0,   0,   0,   0,   0,   0,  86,   0,  87,   0,
+      0,   0,   0,   0,   0,   0, 167,   0,   0,   0,   0,   0,  84,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0, 180,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  22,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,  42,   0,   0,   0,   0,   0,   0,   0,   0, 183,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,  93,   0,   0,   0,   0,  78,   0,   0,   0,
+      0,   0,  10,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 168,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  45,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   4,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 132,   0,
+    154,   0,   0,   0,   0,   0,   0, 136,  13,  91,   0, 178,   0,   0,   0,   0,
+      0,   0,   0,   0,  69,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+};
+
+#endif
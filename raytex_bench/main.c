@@ -0,0 +1,292 @@
+#include <raylib.h>
+#include <raytex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Times building, measuring, drawing and unloading synthetic trees, and reports each per node so that releases can be compared.
+// Usage: raytex_bench [--font file.ttf] [--iterations n] [--depth n] [--fanout n] [--chain n] [--row n] [--matrix n] [--intern]
+// With --font the benchmark runs without a window and draws through CountRayTeXBatchBreaks(), which walks the same
+// draw path as DrawRayTeXEx() but records nothing. Without it, a hidden window is opened and DrawRayTeXEx() is timed.
+// With --intern the trees are built with a RayTeXInterner set, and unloading includes unloading the interner.
+
+#define MAX_FANOUT 16 // GenRayTeX*() take their children as arguments, so fan-out is limited to what BuildTree() passes
+
+typedef enum {
+    PHASE_BUILD,
+    PHASE_MEASURE,
+    PHASE_MEASURE_CACHED,
+    PHASE_DRAW,
+    PHASE_UNLOAD,
+    PHASE_COUNT,
+} Phase;
+
+static const char *phaseNames[PHASE_COUNT] = { "build", "measure", "measure (cached)", "draw", "unload" };
+
+typedef struct Options {
+    const char *fontFileName;
+    int iterations;
+    int depth;
+    int fanout;
+    int chain;
+    int row;
+    int matrix;
+    bool isInterning;
+} Options;
+
+typedef struct Scenario {
+    const char *name;
+    const char *buildName; // What the build phase calls
+    RayTeX (*Build)(const Options *options, char *source);
+    int sourceSize;        // Bytes of source text the scenario needs to outlive its tree
+} Scenario;
+
+typedef struct Counters {
+    long long allocCount;
+    long long freeCount;
+} Counters;
+
+static Counters counters = { 0 };
+
+static void *CountingAlloc(void *userData, size_t size)
+{
+    counters.allocCount++;
+    return malloc(size);
+}
+
+static void CountingFree(void *userData, void *ptr)
+{
+    if (ptr != NULL) counters.freeCount++;
+    free(ptr);
+}
+
+static double GetSeconds(void)
+{
+    struct timespec time = { 0 };
+    timespec_get(&time, TIME_UTC);
+    return (double)time.tv_sec + (double)time.tv_nsec*1e-9;
+}
+
+static int CountNodes(const RayTeX *tex)
+{
+    int count = 1;
+    switch (tex->mode)
+    {
+    case TEXMODE_FRAC:
+        count += CountNodes(tex->frac.content[TEX_FRAC_NUMERATOR].ptr);
+        count += CountNodes(tex->frac.content[TEX_FRAC_DENOMINATOR].ptr);
+        break;
+
+    case TEXMODE_HORIZONTAL:
+        for (int i = 0; i < tex->horizontal.elementCount; ++i) count += CountNodes(tex->horizontal.content[i].ptr);
+        break;
+
+    case TEXMODE_VERTICAL:
+        for (int i = 0; i < tex->vertical.elementCount; ++i) count += CountNodes(tex->vertical.content[i].ptr);
+        break;
+
+    case TEXMODE_MATRIX:
+        for (int i = 0; i < tex->matrix.rowCount*tex->matrix.columnCount; ++i) count += CountNodes(tex->matrix.content[i].ptr);
+        break;
+
+    default: break;
+    }
+    return count;
+}
+
+// Alternates horizontal and vertical lists, with text and symbols at the leaves
+static RayTeX BuildTree(int depth, int fanout, int *leafIndex)
+{
+    if (depth == 0)
+    {
+        int index = (*leafIndex)++;
+        return (index % 4 == 3) ? GenRayTeXSymbol(TEXSYMBOL_NEQ) : GenRayTeXTextf("x%i", index);
+    }
+
+    RayTeX children[MAX_FANOUT] = { 0 };
+    char fmt[MAX_FANOUT + 1] = { 0 };
+    for (int i = 0; i < fanout; ++i)
+    {
+        children[i] = BuildTree(depth - 1, fanout, leafIndex);
+        fmt[i] = 'v';
+    }
+
+    // Unused arguments past the end of fmt are ignored
+    if (depth % 2 == 0)
+    {
+        return GenRayTeXVertical(fmt, children[0], children[1], children[2], children[3], children[4], children[5], children[6], children[7],
+            children[8], children[9], children[10], children[11], children[12], children[13], children[14], children[15]);
+    }
+    return GenRayTeXHorizontal(fmt, children[0], children[1], children[2], children[3], children[4], children[5], children[6], children[7],
+        children[8], children[9], children[10], children[11], children[12], children[13], children[14], children[15]);
+}
+
+static RayTeX BuildTreeScenario(const Options *options, char *source)
+{
+    int leafIndex = 0;
+    return BuildTree(options->depth, options->fanout, &leafIndex);
+}
+
+// Continued fraction, nested through the denominator
+static RayTeX BuildFracChain(const Options *options, char *source)
+{
+    RayTeX tex = GenRayTeXText("x");
+    for (int i = 0; i < options->chain; ++i) tex = GenRayTeXFrac('t', 'v', "1", GenRayTeXHorizontal("tv", "1 + ", tex));
+    return tex;
+}
+
+// A single wide horizontal row, parsed since GenRayTeXHorizontal() cannot take a variable number of children
+static RayTeX BuildRow(const Options *options, char *source)
+{
+    int length = 0;
+    for (int i = 0; i < options->row; ++i) length += sprintf(source + length, (i % 2 == 0) ? "a%i " : "\\leq ", i);
+    return ParseRayTeX(source);
+}
+
+static RayTeX BuildMatrix(const Options *options, char *source)
+{
+    int length = 0;
+    for (int row = 0; row < options->matrix; ++row)
+    {
+        for (int column = 0; column < options->matrix; ++column)
+        {
+            length += sprintf(source + length, "%s\\frac{%i}{%i}", (column > 0) ? " & " : "", row, column);
+        }
+        length += sprintf(source + length, " \\\\ ");
+    }
+    return ParseRayTeX(source);
+}
+
+static void RunScenario(const Scenario *scenario, const Options *options, Font font, bool isHeadless)
+{
+    char *source = (scenario->sourceSize > 0) ? malloc(scenario->sourceSize) : NULL;
+    double seconds[PHASE_COUNT] = { 0 };
+    long long allocCounts[PHASE_COUNT] = { 0 };
+    long long nodeCount = 0;
+    int fontSize = 20;
+
+    for (int iteration = 0; iteration < options->iterations; ++iteration)
+    {
+        Counters start = counters;
+        double time = GetSeconds();
+        RayTeXInterner interner = LoadRayTeXInterner();
+        if (options->isInterning) SetRayTeXInterner(&interner);
+        RayTeX tex = scenario->Build(options, source);
+        SetRayTeXInterner(NULL);
+        seconds[PHASE_BUILD] += GetSeconds() - time;
+        allocCounts[PHASE_BUILD] += counters.allocCount - start.allocCount;
+        nodeCount += CountNodes(&tex);
+
+        start = counters;
+        time = GetSeconds();
+        Vector2 size = MeasureRayTeXEx(font, tex, fontSize);
+        seconds[PHASE_MEASURE] += GetSeconds() - time;
+        allocCounts[PHASE_MEASURE] += counters.allocCount - start.allocCount;
+
+        start = counters;
+        time = GetSeconds();
+        MeasureRayTeXEx(font, tex, fontSize);
+        seconds[PHASE_MEASURE_CACHED] += GetSeconds() - time;
+        allocCounts[PHASE_MEASURE_CACHED] += counters.allocCount - start.allocCount;
+
+        start = counters;
+        if (isHeadless)
+        {
+            time = GetSeconds();
+            CountRayTeXBatchBreaks(font, tex, fontSize);
+            seconds[PHASE_DRAW] += GetSeconds() - time;
+        }
+        else
+        {
+            BeginDrawing();
+            ClearBackground(RAYWHITE);
+            time = GetSeconds();
+            DrawRayTeXEx(font, tex, 0, 0, fontSize, BLACK);
+            seconds[PHASE_DRAW] += GetSeconds() - time;
+            EndDrawing();
+        }
+        allocCounts[PHASE_DRAW] += counters.allocCount - start.allocCount;
+
+        if (iteration == 0)
+        {
+            printf("%s: %lli nodes, %.0fx%.0f px, %i batch breaks\n", scenario->name, nodeCount, size.x, size.y, CountRayTeXBatchBreaks(font, tex, fontSize));
+        }
+
+        start = counters;
+        time = GetSeconds();
+        UnloadRayTeX(tex);
+        UnloadRayTeXInterner(&interner);
+        seconds[PHASE_UNLOAD] += GetSeconds() - time;
+        allocCounts[PHASE_UNLOAD] += counters.allocCount - start.allocCount;
+    }
+
+    for (int phase = 0; phase < PHASE_COUNT; ++phase)
+    {
+        const char *name = (phase == PHASE_BUILD) ? scenario->buildName : phaseNames[phase];
+        printf("    %-18s %10.1f ns/node %8.2f allocs/node\n", name, seconds[phase]*1e9 / (double)nodeCount, (double)allocCounts[phase] / (double)nodeCount);
+    }
+    free(source);
+}
+
+static int ParseOption(int argc, char **argv, int *index, int defaultValue)
+{
+    if (*index + 1 >= argc) return defaultValue;
+    int value = atoi(argv[++(*index)]);
+    return (value > 0) ? value : defaultValue;
+}
+
+int main(int argc, char **argv)
+{
+    Options options = { NULL, 20, 6, 4, 200, 5000, 40, false };
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((strcmp(argv[i], "--font") == 0) && (i + 1 < argc)) options.fontFileName = argv[++i];
+        else if (strcmp(argv[i], "--iterations") == 0) options.iterations = ParseOption(argc, argv, &i, options.iterations);
+        else if (strcmp(argv[i], "--depth") == 0) options.depth = ParseOption(argc, argv, &i, options.depth);
+        else if (strcmp(argv[i], "--fanout") == 0) options.fanout = ParseOption(argc, argv, &i, options.fanout);
+        else if (strcmp(argv[i], "--chain") == 0) options.chain = ParseOption(argc, argv, &i, options.chain);
+        else if (strcmp(argv[i], "--row") == 0) options.row = ParseOption(argc, argv, &i, options.row);
+        else if (strcmp(argv[i], "--matrix") == 0) options.matrix = ParseOption(argc, argv, &i, options.matrix);
+        else if (strcmp(argv[i], "--intern") == 0) options.isInterning = true;
+        else
+        {
+            printf("Usage: %s [--font file.ttf] [--iterations n] [--depth n] [--fanout n] [--chain n] [--row n] [--matrix n] [--intern]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (options.fanout > MAX_FANOUT) options.fanout = MAX_FANOUT;
+
+    SetTraceLogLevel(LOG_WARNING);
+    RayTeXAllocator allocator = { NULL, CountingAlloc, CountingFree };
+    SetRayTeXAllocator(allocator);
+
+    bool isHeadless = (options.fontFileName != NULL);
+    Font font = { 0 };
+    if (isHeadless) font = LoadRayTeXFontMetrics(options.fontFileName, 32, NULL, 0);
+    else
+    {
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        InitWindow(640, 480, "RayTeX Benchmark");
+        font = GetFontDefault();
+    }
+    if (font.glyphs == NULL)
+    {
+        printf("Failed to load a font\n");
+        return 1;
+    }
+
+    Scenario scenarios[] = {
+        { "tree", "GenRayTeX*", BuildTreeScenario, 0 },
+        { "frac chain", "GenRayTeX*", BuildFracChain, 0 },
+        { "wide row", "ParseRayTeX", BuildRow, options.row*16 + 1 },
+        { "matrix", "ParseRayTeX", BuildMatrix, options.matrix*options.matrix*32 + options.matrix*8 + 1 },
+    };
+    printf("%i iterations, %s%s\n", options.iterations, isHeadless ? "headless (null draw sink)" : "hidden window", options.isInterning ? ", interning" : "");
+    for (int i = 0; i < (int)(sizeof(scenarios)/sizeof(scenarios[0])); ++i) RunScenario(&scenarios[i], &options, font, isHeadless);
+
+    SetRayTeXAllocator(GetRayTeXDefaultAllocator());
+    if (isHeadless) UnloadRayTeXFontMetrics(font);
+    else CloseWindow();
+    return 0;
+}
@@ -0,0 +1,322 @@
+#!/usr/bin/env python3
+# Generates raytex/raytex_symbols.h: the RayTeXSymbol enum, per-symbol data,
+# and a perfect hash over every symbol name for RayTeXSymbolFromName().
+#
+# Run from the repository root after editing SYMBOLS or ALIASES:
+#     python tools/gen_raytex_symbols.py
+
+import os
+
+# (enum suffix, TeX name, codepoint, class)
+# Classes decide the spacing around a symbol: ORD none, OP thin, BIN medium, REL thick
+SYMBOLS = [
+    # Relations (NEQ stays first so that existing values do not change)
+    ("NEQ", "neq", 0x2260, "REL"),
+    ("LEQ", "leq", 0x2264, "REL"),
+    ("GEQ", "geq", 0x2265, "REL"),
+    ("EQUIV", "equiv", 0x2261, "REL"),
+    ("APPROX", "approx", 0x2248, "REL"),
+    ("SIM", "sim", 0x223C, "REL"),
+    ("SIMEQ", "simeq", 0x2243, "REL"),
+    ("CONG", "cong", 0x2245, "REL"),
+    ("PROPTO", "propto", 0x221D, "REL"),
+    ("LL", "ll", 0x226A, "REL"),
+    ("GG", "gg", 0x226B, "REL"),
+    ("SUBSET", "subset", 0x2282, "REL"),
+    ("SUPSET", "supset", 0x2283, "REL"),
+    ("SUBSETEQ", "subseteq", 0x2286, "REL"),
+    ("SUPSETEQ", "supseteq", 0x2287, "REL"),
+    ("IN", "in", 0x2208, "REL"),
+    ("NI", "ni", 0x220B, "REL"),
+    ("NOTIN", "notin", 0x2209, "REL"),
+    ("PERP", "perp", 0x22A5, "REL"),
+    ("PARALLEL", "parallel", 0x2225, "REL"),
+    ("MID", "mid", 0x2223, "REL"),
+    ("PREC", "prec", 0x227A, "REL"),
+    ("SUCC", "succ", 0x227B, "REL"),
+    ("PRECEQ", "preceq", 0x2AAF, "REL"),
+    ("SUCCEQ", "succeq", 0x2AB0, "REL"),
+    ("DOTEQ", "doteq", 0x2250, "REL"),
+    ("MODELS", "models", 0x22A8, "REL"),
+    ("VDASH", "vdash", 0x22A2, "REL"),
+    ("DASHV", "dashv", 0x22A3, "REL"),
+    ("ASYMP", "asymp", 0x224D, "REL"),
+    ("BOWTIE", "bowtie", 0x22C8, "REL"),
+    ("SMILE", "smile", 0x2323, "REL"),
+    ("FROWN", "frown", 0x2322, "REL"),
+
+    # Arrows
+    ("LEFTARROW", "leftarrow", 0x2190, "REL"),
+    ("RIGHTARROW", "rightarrow", 0x2192, "REL"),
+    ("UPARROW", "uparrow", 0x2191, "REL"),
+    ("DOWNARROW", "downarrow", 0x2193, "REL"),
+    ("LEFTRIGHTARROW", "leftrightarrow", 0x2194, "REL"),
+    ("UPDOWNARROW", "updownarrow", 0x2195, "REL"),
+    ("DOUBLE_LEFTARROW", "Leftarrow", 0x21D0, "REL"),
+    ("DOUBLE_RIGHTARROW", "Rightarrow", 0x21D2, "REL"),
+    ("DOUBLE_UPARROW", "Uparrow", 0x21D1, "REL"),
+    ("DOUBLE_DOWNARROW", "Downarrow", 0x21D3, "REL"),
+    ("DOUBLE_LEFTRIGHTARROW", "Leftrightarrow", 0x21D4, "REL"),
+    ("LONGLEFTARROW", "longleftarrow", 0x27F5, "REL"),
+    ("LONGRIGHTARROW", "longrightarrow", 0x27F6, "REL"),
+    ("LONGLEFTRIGHTARROW", "longleftrightarrow", 0x27F7, "REL"),
+    ("DOUBLE_LONGLEFTARROW", "Longleftarrow", 0x27F8, "REL"),
+    ("DOUBLE_LONGRIGHTARROW", "Longrightarrow", 0x27F9, "REL"),
+    ("DOUBLE_LONGLEFTRIGHTARROW", "Longleftrightarrow", 0x27FA, "REL"),
+    ("MAPSTO", "mapsto", 0x21A6, "REL"),
+    ("HOOKLEFTARROW", "hookleftarrow", 0x21A9, "REL"),
+    ("HOOKRIGHTARROW", "hookrightarrow", 0x21AA, "REL"),
+    ("NEARROW", "nearrow", 0x2197, "REL"),
+    ("SEARROW", "searrow", 0x2198, "REL"),
+    ("SWARROW", "swarrow", 0x2199, "REL"),
+    ("NWARROW", "nwarrow", 0x2196, "REL"),
+    ("LEFTHARPOONUP", "leftharpoonup", 0x21BC, "REL"),
+    ("RIGHTHARPOONUP", "rightharpoonup", 0x21C0, "REL"),
+    ("RIGHTLEFTHARPOONS", "rightleftharpoons", 0x21CC, "REL"),
+
+    # Binary operators
+    ("PM", "pm", 0x00B1, "BIN"),
+    ("MP", "mp", 0x2213, "BIN"),
+    ("TIMES", "times", 0x00D7, "BIN"),
+    ("DIV", "div", 0x00F7, "BIN"),
+    ("CDOT", "cdot", 0x22C5, "BIN"),
+    ("AST", "ast", 0x2217, "BIN"),
+    ("STAR", "star", 0x22C6, "BIN"),
+    ("CIRC", "circ", 0x2218, "BIN"),
+    ("BULLET", "bullet", 0x2219, "BIN"),
+    ("CAP", "cap", 0x2229, "BIN"),
+    ("CUP", "cup", 0x222A, "BIN"),
+    ("WEDGE", "wedge", 0x2227, "BIN"),
+    ("VEE", "vee", 0x2228, "BIN"),
+    ("SETMINUS", "setminus", 0x2216, "BIN"),
+    ("OPLUS", "oplus", 0x2295, "BIN"),
+    ("OMINUS", "ominus", 0x2296, "BIN"),
+    ("OTIMES", "otimes", 0x2297, "BIN"),
+    ("OSLASH", "oslash", 0x2298, "BIN"),
+    ("ODOT", "odot", 0x2299, "BIN"),
+    ("UPLUS", "uplus", 0x228E, "BIN"),
+    ("SQCAP", "sqcap", 0x2293, "BIN"),
+    ("SQCUP", "sqcup", 0x2294, "BIN"),
+    ("DIAMOND", "diamond", 0x22C4, "BIN"),
+    ("BIGTRIANGLEUP", "bigtriangleup", 0x25B3, "BIN"),
+    ("BIGTRIANGLEDOWN", "bigtriangledown", 0x25BD, "BIN"),
+    ("TRIANGLELEFT", "triangleleft", 0x25C1, "BIN"),
+    ("TRIANGLERIGHT", "triangleright", 0x25B7, "BIN"),
+    ("WR", "wr", 0x2240, "BIN"),
+    ("AMALG", "amalg", 0x2A3F, "BIN"),
+    ("DAGGER", "dagger", 0x2020, "BIN"),
+    ("DDAGGER", "ddagger", 0x2021, "BIN"),
+
+    # Large operators
+    ("SUM", "sum", 0x2211, "OP"),
+    ("PROD", "prod", 0x220F, "OP"),
+    ("COPROD", "coprod", 0x2210, "OP"),
+    ("INT", "int", 0x222B, "OP"),
+    ("OINT", "oint", 0x222E, "OP"),
+    ("BIGCAP", "bigcap", 0x22C2, "OP"),
+    ("BIGCUP", "bigcup", 0x22C3, "OP"),
+    ("BIGWEDGE", "bigwedge", 0x22C0, "OP"),
+    ("BIGVEE", "bigvee", 0x22C1, "OP"),
+    ("BIGOPLUS", "bigoplus", 0x2A01, "OP"),
+    ("BIGOTIMES", "bigotimes", 0x2A02, "OP"),
+
+    # Miscellaneous
+    ("INFTY", "infty", 0x221E, "ORD"),
+    ("PARTIAL", "partial", 0x2202, "ORD"),
+    ("NABLA", "nabla", 0x2207, "ORD"),
+    ("FORALL", "forall", 0x2200, "ORD"),
+    ("EXISTS", "exists", 0x2203, "ORD"),
+    ("NEG", "neg", 0x00AC, "ORD"),
+    ("EMPTYSET", "emptyset", 0x2205, "ORD"),
+    ("ALEPH", "aleph", 0x2135, "ORD"),
+    ("HBAR", "hbar", 0x210F, "ORD"),
+    ("ELL", "ell", 0x2113, "ORD"),
+    ("WP", "wp", 0x2118, "ORD"),
+    ("RE", "Re", 0x211C, "ORD"),
+    ("IM", "Im", 0x2111, "ORD"),
+    ("ANGLE", "angle", 0x2220, "ORD"),
+    ("TRIANGLE", "triangle", 0x25B3, "ORD"),
+    ("PRIME", "prime", 0x2032, "ORD"),
+    ("SURD", "surd", 0x221A, "ORD"),
+    ("TOP", "top", 0x22A4, "ORD"),
+    ("BOT", "bot", 0x22A5, "ORD"),
+    ("LDOTS", "ldots", 0x2026, "ORD"),
+    ("CDOTS", "cdots", 0x22EF, "ORD"),
+    ("VDOTS", "vdots", 0x22EE, "ORD"),
+    ("DDOTS", "ddots", 0x22F1, "ORD"),
+    ("BACKSLASH", "backslash", 0x005C, "ORD"),
+    ("CLUBSUIT", "clubsuit", 0x2663, "ORD"),
+    ("DIAMONDSUIT", "diamondsuit", 0x2662, "ORD"),
+    ("HEARTSUIT", "heartsuit", 0x2661, "ORD"),
+    ("SPADESUIT", "spadesuit", 0x2660, "ORD"),
+    ("FLAT", "flat", 0x266D, "ORD"),
+    ("NATURAL", "natural", 0x266E, "ORD"),
+    ("SHARP", "sharp", 0x266F, "ORD"),
+
+    # Greek letters
+    ("ALPHA", "alpha", 0x03B1, "ORD"),
+    ("BETA", "beta", 0x03B2, "ORD"),
+    ("GAMMA", "gamma", 0x03B3, "ORD"),
+    ("DELTA", "delta", 0x03B4, "ORD"),
+    ("EPSILON", "epsilon", 0x03F5, "ORD"),
+    ("VAREPSILON", "varepsilon", 0x03B5, "ORD"),
+    ("ZETA", "zeta", 0x03B6, "ORD"),
+    ("ETA", "eta", 0x03B7, "ORD"),
+    ("THETA", "theta", 0x03B8, "ORD"),
+    ("VARTHETA", "vartheta", 0x03D1, "ORD"),
+    ("IOTA", "iota", 0x03B9, "ORD"),
+    ("KAPPA", "kappa", 0x03BA, "ORD"),
+    ("LAMBDA", "lambda", 0x03BB, "ORD"),
+    ("MU", "mu", 0x03BC, "ORD"),
+    ("NU", "nu", 0x03BD, "ORD"),
+    ("XI", "xi", 0x03BE, "ORD"),
+    ("PI", "pi", 0x03C0, "ORD"),
+    ("VARPI", "varpi", 0x03D6, "ORD"),
+    ("RHO", "rho", 0x03C1, "ORD"),
+    ("VARRHO", "varrho", 0x03F1, "ORD"),
+    ("SIGMA", "sigma", 0x03C3, "ORD"),
+    ("VARSIGMA", "varsigma", 0x03C2, "ORD"),
+    ("TAU", "tau", 0x03C4, "ORD"),
+    ("UPSILON", "upsilon", 0x03C5, "ORD"),
+    ("PHI", "phi", 0x03D5, "ORD"),
+    ("VARPHI", "varphi", 0x03C6, "ORD"),
+    ("CHI", "chi", 0x03C7, "ORD"),
+    ("PSI", "psi", 0x03C8, "ORD"),
+    ("OMEGA", "omega", 0x03C9, "ORD"),
+    ("CAPITAL_GAMMA", "Gamma", 0x0393, "ORD"),
+    ("CAPITAL_DELTA", "Delta", 0x0394, "ORD"),
+    ("CAPITAL_THETA", "Theta", 0x0398, "ORD"),
+    ("CAPITAL_LAMBDA", "Lambda", 0x039B, "ORD"),
+    ("CAPITAL_XI", "Xi", 0x039E, "ORD"),
+    ("CAPITAL_PI", "Pi", 0x03A0, "ORD"),
+    ("CAPITAL_SIGMA", "Sigma", 0x03A3, "ORD"),
+    ("CAPITAL_UPSILON", "Upsilon", 0x03A5, "ORD"),
+    ("CAPITAL_PHI", "Phi", 0x03A6, "ORD"),
+    ("CAPITAL_PSI", "Psi", 0x03A8, "ORD"),
+    ("CAPITAL_OMEGA", "Omega", 0x03A9, "ORD"),
+]
+
+# Extra names for symbols above
+ALIASES = [
+    ("ne", "NEQ"),
+    ("le", "LEQ"),
+    ("ge", "GEQ"),
+    ("gets", "LEFTARROW"),
+    ("to", "RIGHTARROW"),
+    ("owns", "NI"),
+    ("land", "WEDGE"),
+    ("lor", "VEE"),
+    ("lnot", "NEG"),
+    ("implies", "DOUBLE_LONGRIGHTARROW"),
+    ("iff", "DOUBLE_LONGLEFTRIGHTARROW"),
+]
+
+MASK = 0xFFFFFFFF
+
+
+# Must match rHashSymbolName() in raytex.c
+def hash_name(name, seed):
+    h = (2166136261 ^ seed) & MASK
+    for byte in name.encode("ascii"):
+        h ^= byte
+        h = (h * 16777619) & MASK
+    h ^= h >> 16
+    return h
+
+
+def find_perfect_hash(names):
+    size = 1
+    while size < len(names) * 4:
+        size *= 2
+    while True:
+        for seed in range(1, 1 << 20):
+            slots = {}
+            for index, name in enumerate(names):
+                slot = hash_name(name, seed) & (size - 1)
+                if slot in slots:
+                    break
+                slots[slot] = index
+            else:
+                return size, seed, slots
+        size *= 2
+
+
+def main():
+    enum_suffixes = [symbol[0] for symbol in SYMBOLS]
+    names = [symbol[1] for symbol in SYMBOLS] + [alias[0] for alias in ALIASES]
+    values = list(range(len(SYMBOLS))) + [enum_suffixes.index(alias[1]) for alias in ALIASES]
+    assert len(set(names)) == len(names), "duplicate symbol name"
+    assert len(names) < 0xFFFF
+
+    size, seed, slots = find_perfect_hash(names)
+    table = [0] * size
+    for slot, index in slots.items():
+        table[slot] = index + 1
+
+    out = []
+    out.append("// Generated by tools/gen_raytex_symbols.py - do not edit by hand")
+    out.append("#ifndef RAYTEX_SYMBOLS_H")
+    out.append("#define RAYTEX_SYMBOLS_H")
+    out.append("")
+    out.append("typedef enum {")
+    out.append("    TEXSYMBOL_UNKNOWN = -1, // Returned by RayTeXSymbolFromName() for names that are not symbols")
+    width = max(len(suffix) for suffix in enum_suffixes)
+    for suffix, name, codepoint, _ in SYMBOLS:
+        out.append("    TEXSYMBOL_%s,%s // \\%s U+%04X" % (suffix, " " * (width - len(suffix)), name, codepoint))
+    out.append("    TEXSYMBOL_COUNT,")
+    out.append("} RayTeXSymbol;")
+    out.append("")
+    out.append("#endif")
+    out.append("")
+    out.append("#if defined(RAYTEX_SYMBOLS_IMPLEMENTATION) && !defined(RAYTEX_SYMBOLS_IMPLEMENTATION_DEFINED)")
+    out.append("#define RAYTEX_SYMBOLS_IMPLEMENTATION_DEFINED")
+    out.append("")
+    out.append("enum {")
+    out.append("    TEXSYMBOLCLASS_ORD,")
+    out.append("    TEXSYMBOLCLASS_OP,")
+    out.append("    TEXSYMBOLCLASS_BIN,")
+    out.append("    TEXSYMBOLCLASS_REL,")
+    out.append("};")
+    out.append("")
+    out.append("static const int symbolCodepoints[TEXSYMBOL_COUNT] = {")
+    for suffix, _, codepoint, _ in SYMBOLS:
+        out.append("    0x%04X, // TEXSYMBOL_%s" % (codepoint, suffix))
+    out.append("};")
+    out.append("")
+    out.append("static const unsigned char symbolClasses[TEXSYMBOL_COUNT] = {")
+    for suffix, _, _, symbol_class in SYMBOLS:
+        out.append("    TEXSYMBOLCLASS_%s, // TEXSYMBOL_%s" % (symbol_class, suffix))
+    out.append("};")
+    out.append("")
+    out.append("#define SYMBOL_NAME_COUNT %i" % len(names))
+    out.append("")
+    out.append("static const char *const symbolNames[SYMBOL_NAME_COUNT] = {")
+    for name in names:
+        out.append("    \"%s\"," % name)
+    out.append("};")
+    out.append("")
+    out.append("static const RayTeXSymbol symbolNameValues[SYMBOL_NAME_COUNT] = {")
+    for name, value in zip(names, values):
+        out.append("    TEXSYMBOL_%s, // %s" % (enum_suffixes[value], name))
+    out.append("};")
+    out.append("")
+    out.append("// Perfect hash: every name lands in its own slot, which holds its index in symbolNames plus one")
+    out.append("#define SYMBOL_HASH_SEED %iu" % seed)
+    out.append("#define SYMBOL_HASH_TABLE_SIZE %i" % size)
+    out.append("")
+    out.append("static const unsigned short symbolHashSlots[SYMBOL_HASH_TABLE_SIZE] = {")
+    for row in range(0, size, 16):
+        out.append("    " + " ".join("%3i," % entry for entry in table[row:row + 16]))
+    out.append("};")
+    out.append("")
+    out.append("#endif")
+    out.append("")
+
+    path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "raytex", "raytex_symbols.h")
+    with open(path, "w", newline="\n") as file:
+        file.write("\n".join(out))
+    print("Wrote %i symbols (%i names) with seed %i into %i slots" % (len(SYMBOLS), len(names), seed, size))
+
+
+if __name__ == "__main__":
+    main()